@@ -0,0 +1,76 @@
+#include <iostream>
+#include <sstream>
+#include "BinaryTrace.h"
+#include "DES.h"
+#include "Random.h"
+
+int main() {
+    // des_test_3 in binary, 8 events per block
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    std::stringstream file;
+    {
+        DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+        BinaryTraceSink sink(file, 8);
+        sim.setTraceSink(sink);
+        sim.run();
+    }
+
+    // part 1: Block index
+    BinaryTraceReader reader(file);
+    std::cout << "Valid: " << reader.isValid() << ", bytes: " << file.str().size()
+              << ", blocks: " << reader.blockCount() << ", events: " << reader.eventCount() << std::endl;
+    for (int b = 0; b < reader.blockCount(); b++) {
+        const BinaryTraceBlock& info = reader.block(b);
+        std::cout << "Block " << b << ": events " << info.events << ", time " << info.minTime << ".." << info.maxTime
+                  << ", patients " << info.minPatient << ".." << info.maxPatient << std::endl;
+    }
+
+    // part 2: Queries only decode the blocks they need
+    OStreamTraceSink out(std::cout);
+    int decoded = reader.query(9, 10, -1, out);
+    std::cout << "Time 9..10 decoded blocks: " << decoded << std::endl;
+    decoded = reader.query(0, 100, 4, out);
+    std::cout << "Patient 4 decoded blocks: " << decoded << std::endl;
+
+    // part 3: Back to text, the same as des_test_3.out
+    reader.replay(out);
+
+    // part 4: Not a trace
+    std::stringstream junk("DESTRACE but nothing else");
+    BinaryTraceReader bad(junk);
+    std::cout << "Junk valid: " << bad.isValid() << ", blocks: " << bad.blockCount() << std::endl;
+
+    // part 5: Corrupted traces, 4 events per block. A trace that still
+    // reads as valid has counts that fit its bytes, so replaying it is safe.
+    std::stringstream small;
+    {
+        DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+        BinaryTraceSink sink(small, 4);
+        sim.setTraceSink(sink);
+        sim.run();
+    }
+    const std::string original = small.str();
+    Random rng(13);
+    int accepted = 0;
+    bool bounded = true;
+    for (int trial = 0; trial < 3000; trial++) {
+        std::string bytes = original;
+        int flips = 1 + rng.nextInt(3);
+        for (int f = 0; f < flips; f++) {
+            bytes[rng.nextInt((int)bytes.size())] = (char)rng.nextInt(256);
+        }
+        std::stringstream corrupted(bytes);
+        BinaryTraceReader reader(corrupted);
+        if (!reader.isValid()) {
+            continue;
+        }
+        accepted++;
+        bounded = bounded && reader.eventCount() * 3 <= (long long)bytes.size();
+        std::ostringstream text;
+        OStreamTraceSink sink(text);
+        reader.replay(sink);
+    }
+    std::cout << "Corrupted traces accepted: " << (accepted > 0) << ", counts bounded: " << bounded << std::endl;
+    return 0;
+}
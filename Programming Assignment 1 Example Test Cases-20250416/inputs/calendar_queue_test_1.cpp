@@ -0,0 +1,63 @@
+#include "CalendarQueue.h"
+#include "SortedLinkedList.h"
+#include <iostream>
+
+int main() {
+    CalendarQueue calendar;
+    SortedLinkedList reference;
+
+    // part 1: Empty queue
+    std::cout << "Is queue empty? " << calendar.isEmpty() << std::endl;
+
+    // part 2: Same events as the sorted list test
+    calendar.add(Event(20, TriageQueueEntrance, 10, -1));
+    calendar.add(Event(10, DoctorEntrance, 5, 1));
+    calendar.add(Event(15, TriageLeave, 8, 3));
+    calendar.add(Event(5, PatientLeaveHospital, 3, 2));
+    std::cout << "Is queue empty? " << calendar.isEmpty() << std::endl;
+    std::cout << "First: " << calendar.getFirst() << std::endl;
+    std::cout << "Last: " << calendar.getLast() << std::endl;
+    while (!calendar.isEmpty()) {
+        std::cout << calendar.removeSmallest() << std::endl;
+    }
+
+    // part 3: Hold model, the queue resizes several times on the way up and down
+    unsigned int seed = 12345;
+    int now = 0;
+    bool same = true;
+    for (int i = 0; i < 3000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        Event e(now + (int)((seed >> 16) % 50), (EventType)((seed >> 8) % 8), (int)(seed % 97), (int)((seed >> 4) % 3) - 1);
+        calendar.add(e);
+        reference.add(e);
+        if (i % 3 == 2) {
+            Event a = calendar.removeSmallest();
+            Event b = reference.removeSmallest();
+            now = a.time;
+            if (a < b || b < a) {
+                same = false;
+            }
+        }
+    }
+    std::cout << "Queue length: " << calendar.length() << std::endl;
+    std::cout << "Last matches: " << !(calendar.getLast() < reference.getLast() || reference.getLast() < calendar.getLast()) << std::endl;
+    while (!calendar.isEmpty()) {
+        Event a = calendar.removeSmallest();
+        Event b = reference.removeSmallest();
+        if (a < b || b < a) {
+            same = false;
+        }
+    }
+    std::cout << "Same order as sorted list? " << same << std::endl;
+    std::cout << "Is queue empty? " << calendar.isEmpty() << std::endl;
+
+    // part 4: Event in the past of the current window
+    calendar.add(Event(1000, TriageLeave, 1, 0));
+    calendar.add(Event(1001, TriageLeave, 2, 0));
+    std::cout << calendar.removeSmallest() << std::endl;
+    calendar.add(Event(-3, TriageEntrance, 4, 1));
+    std::cout << calendar.removeSmallest() << std::endl;
+    std::cout << calendar.removeSmallest() << std::endl;
+
+    return 0;
+}
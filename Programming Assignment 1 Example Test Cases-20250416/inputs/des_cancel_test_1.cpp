@@ -0,0 +1,27 @@
+#include <iostream>
+#include "DES.h"
+
+// Boredom events are cancelled when the patient leaves the queue, so only
+// the ones that make a patient leave are left in the trace.
+int main() {
+    PriorityQueue pq;
+    int a = pq.enqueue(Event(5, TriageQueueBoringStart, 0, -1));
+    int b = pq.enqueue(Event(3, TriageEntrance, 1, 0));
+    pq.enqueue(Event(7, DoctorQueueBoringStart, 2, -1));
+    std::cout << "Cancel a: " << pq.cancel(a) << std::endl;
+    std::cout << "Cancel a again: " << pq.cancel(a) << std::endl;
+    std::cout << "Cancel b: " << pq.cancel(b) << std::endl;
+    std::cout << "Length: " << pq.length() << std::endl;
+    std::cout << "First: " << pq.dequeue() << std::endl;
+
+    PriorityQueue sorted(SortedListEngine);
+    int c = sorted.enqueue(Event(1, TriageEntrance, 0, 0));
+    std::cout << "Sorted list handle: " << c << ", cancel: " << sorted.cancel(c) << std::endl;
+
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+    sim.setCancelBoredomTimers(true);
+    sim.run();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <sstream>
+#include "DES.h"
+
+static const char* ENGINE_NAMES[4] = {"heap", "sorted list", "calendar", "radix"};
+
+static bool sameStatistics(const DESStatistics& a, const DESStatistics& b) {
+    return a.eventsProcessed == b.eventsProcessed && a.patientsTreated == b.patientsTreated
+        && a.patientsBored == b.patientsBored && a.finishTime == b.finishTime
+        && a.peakPatients == b.peakPatients && a.boredInTriage == b.boredInTriage
+        && a.boredAtDoctor == b.boredAtDoctor && a.maxTriageQueue == b.maxTriageQueue
+        && a.maxDoctorQueue == b.maxDoctorQueue && a.triageUtilization == b.triageUtilization
+        && a.doctorUtilization == b.doctorUtilization;
+}
+
+int main() {
+    // a busy hospital, so every queue, timer and stack has something in it
+    const int N = 120;
+    int arrivals[N], urgencies[N];
+    for (int i = 0; i < N; i++) {
+        arrivals[i] = i * 2 + (i * 7) % 5;
+        urgencies[i] = (i * 5) % 3;
+    }
+
+    // part 1: Stopping at time 100, checkpointing and restoring gives the
+    // same trace and statistics as one uninterrupted run
+    for (int engine = 0; engine < 4; engine++) {
+        for (int mode = 0; mode < 4; mode++) {
+            bool cancel = (mode & 1) != 0;
+            bool wheel = (mode & 2) != 0;
+            std::ostringstream whole;
+            DES reference(2, 3, 3, 3, 9, 12, N, urgencies, arrivals, (EventSetEngine)engine);
+            reference.setCancelBoredomTimers(cancel);
+            reference.setTimingWheel(wheel);
+            reference.setOutputStream(whole);
+            const DESStatistics& expected = reference.run();
+
+            std::ostringstream first, second;
+            DES sim(2, 3, 3, 3, 9, 12, N, urgencies, arrivals, (EventSetEngine)engine);
+            sim.setCancelBoredomTimers(cancel);
+            sim.setTimingWheel(wheel);
+            sim.setOutputStream(first);
+            bool more = sim.runUntil(100);
+            std::stringstream checkpoint;
+            sim.saveCheckpoint(checkpoint);
+            DES* restored = DES::restoreCheckpoint(checkpoint);
+            if (restored == NULL) {
+                std::cout << ENGINE_NAMES[engine] << ": restore failed" << std::endl;
+                continue;
+            }
+            restored->setOutputStream(second);
+            int clock = restored->currentTime();
+            const DESStatistics& got = restored->run();
+            std::cout << ENGINE_NAMES[engine] << ", cancel " << cancel << ", wheel " << wheel
+                      << ": more " << more << ", clock " << clock
+                      << ", same trace " << (first.str() + second.str() == whole.str())
+                      << ", same statistics " << sameStatistics(got, expected) << std::endl;
+            delete restored;
+        }
+    }
+
+    // part 2: A streaming simulation continues with its arrival source
+    ArrayArrivalSource stream(arrivals, urgencies, N);
+    DES streaming(2, 3, 3, 3, 9, 12, stream);
+    std::ostringstream streamFirst, streamSecond, streamWhole;
+    streaming.setOutputStream(streamFirst);
+    streaming.runUntil(150);
+    std::stringstream streamCheckpoint;
+    streaming.saveCheckpoint(streamCheckpoint);
+    std::cout << "Fork of a streaming run: " << (streaming.fork() == NULL) << std::endl;
+    DES* continued = DES::restoreCheckpoint(streamCheckpoint, &stream);
+    continued->setOutputStream(streamSecond);
+    continued->run();
+    ArrayArrivalSource again(arrivals, urgencies, N);
+    DES direct(2, 3, 3, 3, 9, 12, again);
+    direct.setOutputStream(streamWhole);
+    direct.run();
+    std::cout << "Streaming same trace: " << (streamFirst.str() + streamSecond.str() == streamWhole.str()) << std::endl;
+    delete continued;
+
+    // part 3: Fork at time 60 and give the copy a fourth doctor
+    DES base(2, 3, 3, 3, 9, 12, N, urgencies, arrivals);
+    base.setSummaryOnly(true);
+    base.runUntil(60);
+    DES* whatIf = base.fork();
+    int did = whatIf->addDoctor();
+    const DESStatistics& b = base.run();
+    const DESStatistics& w = whatIf->run();
+    std::cout << "New doctor: " << did << std::endl;
+    std::cout << "Base: treated " << b.patientsTreated << ", bored " << b.patientsBored
+              << ", max doctor queue " << b.maxDoctorQueue << ", doctor utilization " << b.doctorUtilization << std::endl;
+    std::cout << "What if: treated " << w.patientsTreated << ", bored " << w.patientsBored
+              << ", max doctor queue " << w.maxDoctorQueue << ", doctor utilization " << w.doctorUtilization << std::endl;
+    delete whatIf;
+
+    // part 4: des_test_3 forked at time 5 with an extra doctor, traced
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    DES small(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+    small.runUntil(5);
+    DES* extra = small.fork();
+    extra->addDoctor();
+    extra->run();
+    delete extra;
+
+    // part 5: Broken checkpoints are refused
+    std::stringstream good;
+    small.saveCheckpoint(good);
+    std::string bytes = good.str();
+    std::istringstream empty("");
+    std::istringstream wrongMagic("DESCKPT0" + bytes.substr(8));
+    std::istringstream truncated(bytes.substr(0, bytes.size() / 2));
+    std::istringstream trailing(bytes + "x");
+    std::istringstream intact(bytes);
+    std::cout << "Empty: " << (DES::restoreCheckpoint(empty) == NULL) << std::endl;
+    std::cout << "Wrong magic: " << (DES::restoreCheckpoint(wrongMagic) == NULL) << std::endl;
+    std::cout << "Truncated: " << (DES::restoreCheckpoint(truncated) == NULL) << std::endl;
+    std::cout << "Trailing bytes: " << (DES::restoreCheckpoint(trailing) == NULL) << std::endl;
+    DES* ok = DES::restoreCheckpoint(intact);
+    std::cout << "Intact: " << (ok != NULL) << ", with an arrival source: "
+              << (DES::restoreCheckpoint(good, &stream) == NULL) << std::endl;
+    delete ok;
+    return 0;
+}
@@ -0,0 +1,17 @@
+#include <iostream>
+#include "DES.h"
+
+// Same scenario as des_test_3, run once on every event set engine.
+// Every run must print the same trace.
+int main() {
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    EventSetEngine engines[4] = {HeapEngine, SortedListEngine, CalendarEngine, RadixEngine};
+
+    for (int i = 0; i < 4; i++) {
+        std::cout << "Engine " << engines[i] << std::endl;
+        DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times, engines[i]);
+        sim.run();
+    }
+    return 0;
+}
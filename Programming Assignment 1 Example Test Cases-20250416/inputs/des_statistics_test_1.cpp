@@ -0,0 +1,79 @@
+#include <iostream>
+#include <sstream>
+#include "DES.h"
+#include "LogHistogram.h"
+
+static void printHistogram(const char* name, const LogHistogram& h) {
+    std::cout << name << ": count " << h.count() << ", mean " << h.mean() << ", min " << h.min()
+              << ", p50 " << h.percentile(0.5) << ", p90 " << h.percentile(0.9) << ", max " << h.max() << std::endl;
+}
+
+int main() {
+    // part 1: Histogram buckets, exact below 16, 1/16 wide above
+    LogHistogram h;
+    printHistogram("Empty", h);
+    for (int v = 0; v < 16; v++) {
+        h.record(v);
+    }
+    printHistogram("0..15", h);
+    LogHistogram big;
+    for (int v = 1; v <= 100000; v++) {
+        big.record(v);
+    }
+    big.record(-5);
+    printHistogram("0..100000", big);
+    int p99 = big.percentile(0.99);
+    std::cout << "p99 within 1/16: " << (p99 >= 99000 && p99 <= 99000 + 99000 / 16) << std::endl;
+    h.merge(big);
+    std::cout << "Merged count: " << h.count() << ", min " << h.min() << ", max " << h.max() << std::endl;
+
+    // part 2: des_test_3, summary only prints nothing
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+    sim.setSummaryOnly(true);
+    const DESStatistics& stats = sim.run();
+    std::cout << "Events: " << stats.eventsProcessed << ", finish: " << stats.finishTime << std::endl;
+    std::cout << "Treated: " << stats.patientsTreated << ", bored: " << stats.patientsBored
+              << " (triage " << stats.boredInTriage << ", doctor " << stats.boredAtDoctor << ")" << std::endl;
+    std::cout << "Max queues: triage " << stats.maxTriageQueue << ", doctor " << stats.maxDoctorQueue << std::endl;
+    std::cout << "Utilization: triage " << stats.triageUtilization << ", doctor " << stats.doctorUtilization << std::endl;
+    const StatisticsCollector& collector = sim.getCollector();
+    printHistogram("Triage wait", collector.getTriageWait());
+    for (int t = 0; t < 3; t++) {
+        std::cout << "Tier " << t << " bored in triage " << collector.getBoredInTriage(t)
+                  << ", at doctor " << collector.getBoredAtDoctor(t) << ", ";
+        printHistogram("doctor wait", collector.getDoctorWait(t));
+    }
+    printHistogram("Time in hospital", collector.getTimeInHospital());
+
+    // part 3: The same run with a trace gives the same statistics
+    std::ostringstream trace;
+    DES traced(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+    traced.setOutputStream(trace);
+    const DESStatistics& again = traced.run();
+    std::cout << "Same: " << (again.eventsProcessed == stats.eventsProcessed && again.boredAtDoctor == stats.boredAtDoctor
+                              && again.doctorUtilization == stats.doctorUtilization) << std::endl;
+    std::cout << "Trace lines: " << (trace.str().size() > 0) << std::endl;
+
+    // part 4: An overloaded hospital, one patient a time unit
+    int busyArrivals[200], busyUrgencies[200];
+    for (int i = 0; i < 200; i++) {
+        busyArrivals[i] = i;
+        busyUrgencies[i] = i % 3;
+    }
+    DES busy(1, 2, 3, 2, 5, 6, 200, busyUrgencies, busyArrivals);
+    busy.setSummaryOnly(true);
+    const DESStatistics& b = busy.run();
+    std::cout << "Treated: " << b.patientsTreated << ", bored: " << b.patientsBored
+              << " (triage " << b.boredInTriage << ", doctor " << b.boredAtDoctor << ")" << std::endl;
+    std::cout << "Max queues: triage " << b.maxTriageQueue << ", doctor " << b.maxDoctorQueue << std::endl;
+    std::cout << "Utilization: triage " << b.triageUtilization << ", doctor " << b.doctorUtilization << std::endl;
+    for (int t = 0; t < 3; t++) {
+        std::cout << "Tier " << t << " bored in triage " << busy.getCollector().getBoredInTriage(t)
+                  << ", at doctor " << busy.getCollector().getBoredAtDoctor(t)
+                  << ", mean wait " << busy.getMeanWait(t) << std::endl;
+    }
+    printHistogram("Triage wait", busy.getCollector().getTriageWait());
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include "EventHeap.h"
+#include <iostream>
+
+int main() {
+    EventHeap heap;
+
+    // part 1: Empty heap
+    std::cout << "Is heap empty? " << heap.isEmpty() << std::endl;
+
+    // part 2: Add events out of order, ties broken by patientId, type, resourceId
+    heap.add(Event(20, TriageQueueEntrance, 10, -1));
+    heap.add(Event(10, DoctorEntrance, 5, 1));
+    heap.add(Event(10, DoctorEntrance, 5, 0));
+    heap.add(Event(10, TriageLeave, 5, 1));
+    heap.add(Event(15, TriageLeave, 12, 3));
+    heap.add(Event(10, DoctorEntrance, 4, 2));
+    heap.add(Event(5, PatientLeaveHospital, 3, 2));
+    heap.add(Event(30, PatientLeaveHospital, 1, -1));
+
+    std::cout << "Is heap empty? " << heap.isEmpty() << std::endl;
+    std::cout << "Heap length: " << heap.length() << std::endl;
+    std::cout << "First: " << heap.getFirst() << std::endl;
+    std::cout << "Last: " << heap.getLast() << std::endl;
+
+    // part 3: Remove everything in Event::operator< order
+    while (!heap.isEmpty()) {
+        std::cout << heap.removeSmallest() << std::endl;
+    }
+    std::cout << "Is heap empty? " << heap.isEmpty() << std::endl;
+
+    return 0;
+}
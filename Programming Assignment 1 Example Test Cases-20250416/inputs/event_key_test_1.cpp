@@ -0,0 +1,65 @@
+#include <iostream>
+#include <climits>
+#include "EventKey.h"
+#include "EventHeap.h"
+#include "SortedLinkedList.h"
+#include "Random.h"
+
+static bool sameEvent(const Event& a, const Event& b) {
+    return a.time == b.time && a.type == b.type && a.patientId == b.patientId && a.resourceId == b.resourceId;
+}
+
+int main() {
+    // part 1: Round trips, extremes and the default
+    Event samples[5] = {
+        Event(11, DoctorQueueEntrance, 2, 0),
+        Event(-1, TriageQueueEntrance, -1, -1),
+        Event(INT_MAX, DoctorQueueBoringStart, INT_MAX, INT_MAX),
+        Event(INT_MIN, TriageQueueEntrance, INT_MIN, INT_MIN),
+        Event(0, PatientLeaveHospital, 0, 0)
+    };
+    for (int i = 0; i < 5; i++) {
+        EventKey key(samples[i]);
+        std::cout << key.event() << " round trip " << sameEvent(key.event(), samples[i]) << std::endl;
+    }
+    std::cout << "Default: " << EventKey().event() << std::endl;
+
+    // part 2: Key order is Event::operator< order, ties and negatives included
+    Random rng(7);
+    int agree = 0, pairs = 0;
+    for (int i = 0; i < 100000; i++) {
+        Event a(rng.nextInt(5) - 2, (EventType)rng.nextInt(8), rng.nextInt(5) - 2, rng.nextInt(5) - 2);
+        Event b(rng.nextInt(5) - 2, (EventType)rng.nextInt(8), rng.nextInt(5) - 2, rng.nextInt(5) - 2);
+        EventKey ka(a), kb(b);
+        agree += (ka < kb) == (a < b) && (kb < ka) == (b < a);
+        pairs++;
+    }
+    std::cout << "Order agrees: " << agree << " of " << pairs << std::endl;
+    std::cout << "INT_MIN before -1: " << (EventKey(samples[3]) < EventKey(samples[1]))
+              << ", -1 before INT_MAX: " << (EventKey(samples[1]) < EventKey(samples[2])) << std::endl;
+
+    // part 3: The heap and the sorted list store keys, both give the same order
+    EventHeap heap;
+    SortedLinkedList list;
+    for (int i = 0; i < 2000; i++) {
+        Event e(rng.nextInt(50), (EventType)rng.nextInt(8), rng.nextInt(100), rng.nextInt(3) - 1);
+        heap.add(e);
+        list.add(e);
+    }
+    std::cout << "Heap first " << heap.getFirst() << std::endl;
+    std::cout << "List last " << list.getLast() << std::endl;
+    bool same = true, sorted = true;
+    Event previous = heap.getFirst();
+    while (!heap.isEmpty()) {
+        Event h = heap.removeSmallest();
+        Event l = list.removeSmallest();
+        same = same && sameEvent(h, l);
+        sorted = sorted && !(h < previous);
+        previous = h;
+    }
+    std::cout << "Same order: " << same << ", sorted: " << sorted << ", both empty: "
+              << (heap.isEmpty() && list.isEmpty()) << std::endl;
+    std::cout << "Empty heap: " << heap.getFirst() << std::endl;
+    std::cout << "Empty list: " << list.getFirst() << std::endl;
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "FCFSQueue.h"
+#include <iostream>
+
+int main() {
+    FCFSQueue queue;
+
+    // part 1: Empty queue answers 0
+    std::cout << "part 1: Is the queue empty? " << queue.isEmpty() << std::endl;
+    std::cout << "part 1: First, last, dequeue, removeBack: " << queue.getFirst() << " " << queue.getLast()
+              << " " << queue.dequeue() << " " << queue.removeBack() << std::endl;
+
+    // part 2: Wrap around the buffer before it grows
+    for (int i = 1; i <= 6; i++) {
+        queue.enqueue(i);
+    }
+    for (int i = 0; i < 4; i++) {
+        queue.dequeue();
+    }
+    for (int i = 7; i <= 12; i++) {
+        queue.enqueue(i);
+    }
+    std::cout << "part 2: Length: " << queue.length() << ", first: " << queue.getFirst()
+              << ", last: " << queue.getLast() << std::endl;
+
+    // part 3: Grow while wrapped, order is kept
+    for (int i = 13; i <= 20; i++) {
+        queue.enqueue(i);
+    }
+    std::cout << "part 3: Length: " << queue.length() << std::endl;
+
+    // part 4: Bored patients leave from the back
+    std::cout << "part 4: Remove back: " << queue.removeBack() << std::endl;
+    std::cout << "part 4: Remove back: " << queue.removeBack() << std::endl;
+    std::cout << "part 4: Last: " << queue.getLast() << std::endl;
+
+    // part 5: Drain in arrival order
+    std::cout << "part 5:";
+    while (!queue.isEmpty()) {
+        std::cout << " " << queue.dequeue();
+    }
+    std::cout << std::endl;
+    std::cout << "part 5: Is the queue empty? " << queue.isEmpty() << std::endl;
+
+    return 0;
+}
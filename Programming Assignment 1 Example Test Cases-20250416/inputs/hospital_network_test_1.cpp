@@ -0,0 +1,120 @@
+#include <iostream>
+#include <sstream>
+#include "HospitalNetwork.h"
+
+static const int HOSPITALS = 3;
+static const int N = 150;
+
+static int arrivals[HOSPITALS][N];
+static int urgencies[HOSPITALS][N];
+
+// hospital 0 is overloaded, 1 is busy, 2 is quiet
+static void makeNetwork(DES** hospitals, std::ostringstream* traces, bool summaryOnly) {
+    int doctors[HOSPITALS] = {2, 3, 5};
+    for (int h = 0; h < HOSPITALS; h++) {
+        hospitals[h] = new DES(2, doctors[h], 3, 3, 10, 25, N, urgencies[h], arrivals[h]);
+        hospitals[h]->setOutputStream(traces[h]);
+        hospitals[h]->setSummaryOnly(summaryOnly);
+    }
+}
+
+static void printStatistics(int h, const DESStatistics& s) {
+    std::cout << "Hospital " << h << ": events " << s.eventsProcessed << ", treated " << s.patientsTreated
+              << ", bored " << s.patientsBored << ", transferred " << s.patientsTransferred
+              << ", received " << s.patientsReceived << ", finish " << s.finishTime << std::endl;
+}
+
+static bool sameStatistics(const DESStatistics& a, const DESStatistics& b) {
+    return a.eventsProcessed == b.eventsProcessed && a.patientsTreated == b.patientsTreated
+        && a.patientsBored == b.patientsBored && a.finishTime == b.finishTime
+        && a.patientsTransferred == b.patientsTransferred && a.patientsReceived == b.patientsReceived
+        && a.peakPatients == b.peakPatients && a.doctorUtilization == b.doctorUtilization;
+}
+
+static void setRoutes(HospitalNetwork& network) {
+    network.setTransfer(0, 1, 6, 2);
+    network.setTransfer(1, 2, 9, 3);
+    network.setTransfer(2, 0, 15, 4);
+}
+
+int main() {
+    for (int h = 0; h < HOSPITALS; h++) {
+        for (int i = 0; i < N; i++) {
+            arrivals[h][i] = i * (h + 1) + (i * 7 + h) % 3;
+            urgencies[h][i] = (i * 5 + h) % 3;
+        }
+    }
+
+    // part 1: Bad routes are refused
+    DES* hospitals[HOSPITALS];
+    std::ostringstream reference[HOSPITALS];
+    makeNetwork(hospitals, reference, false);
+    HospitalNetwork sequential(hospitals, HOSPITALS);
+    std::cout << "Self: " << sequential.setTransfer(1, 1, 5, 2) << ", bad index: " << sequential.setTransfer(0, 3, 5, 2)
+              << ", no delay: " << sequential.setTransfer(0, 1, 0, 2) << ", bad threshold: "
+              << sequential.setTransfer(0, 1, 5, -1) << std::endl;
+
+    // part 2: The sequential reference, one event at a time
+    setRoutes(sequential);
+    sequential.runSequential();
+    DESStatistics expected[HOSPITALS];
+    for (int h = 0; h < HOSPITALS; h++) {
+        expected[h] = hospitals[h]->getStatistics();
+        printStatistics(h, expected[h]);
+    }
+    std::cout << "Hospital 1 trace tail:" << std::endl;
+    std::string trace = reference[1].str();
+    size_t tail = trace.size();
+    for (int lines = 0; lines < 8 && tail > 0; lines++) {
+        tail = trace.rfind('\n', tail - 2) + 1;
+    }
+    std::cout << trace.substr(tail);
+    for (int h = 0; h < HOSPITALS; h++) {
+        delete hospitals[h];
+    }
+
+    // part 3: In windows on 1 to 4 threads, the same traces
+    for (int threads = 1; threads <= 4; threads++) {
+        std::ostringstream traces[HOSPITALS];
+        makeNetwork(hospitals, traces, false);
+        HospitalNetwork network(hospitals, HOSPITALS);
+        setRoutes(network);
+        network.setThreads(threads);
+        network.run();
+        bool same = true;
+        for (int h = 0; h < HOSPITALS; h++) {
+            same = same && traces[h].str() == reference[h].str()
+                && sameStatistics(hospitals[h]->getStatistics(), expected[h]);
+            delete hospitals[h];
+        }
+        std::cout << threads << " threads: same " << same << ", windows " << network.getWindows() << std::endl;
+    }
+
+    // part 4: Summary only gives the same statistics
+    std::ostringstream unused[HOSPITALS];
+    makeNetwork(hospitals, unused, true);
+    HospitalNetwork summary(hospitals, HOSPITALS);
+    setRoutes(summary);
+    summary.setThreads(3);
+    summary.run();
+    bool same = true;
+    for (int h = 0; h < HOSPITALS; h++) {
+        same = same && sameStatistics(hospitals[h]->getStatistics(), expected[h]) && unused[h].str().empty();
+        delete hospitals[h];
+    }
+    std::cout << "Summary only: same " << same << std::endl;
+
+    // part 5: Without routes every hospital runs alone in one window
+    std::ostringstream alone[HOSPITALS];
+    makeNetwork(hospitals, alone, true);
+    HospitalNetwork separate(hospitals, HOSPITALS);
+    separate.setThreads(2);
+    separate.run();
+    int transferred = 0;
+    for (int h = 0; h < HOSPITALS; h++) {
+        transferred += hospitals[h]->getStatistics().patientsTransferred;
+        delete hospitals[h];
+    }
+    std::cout << "No routes: windows " << separate.getWindows() << ", transferred " << transferred << std::endl;
+    return 0;
+}
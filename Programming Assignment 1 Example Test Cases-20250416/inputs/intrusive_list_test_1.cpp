@@ -0,0 +1,157 @@
+#include <iostream>
+#include <sstream>
+#include "DES.h"
+#include "IntrusiveFCFSQueue.h"
+#include "IntrusiveList.h"
+#include "IntrusiveSortedList.h"
+#include "PatientTable.h"
+#include "Random.h"
+#include "SortedLinkedList.h"
+
+// a record in two lists at once, one hook each
+struct Job {
+    int priority;
+    ListHook byArrival;
+    ListHook byPriority;
+};
+
+typedef IntrusiveList<Job*, Job, &Job::byArrival> ArrivalList;
+typedef IntrusiveList<Job*, Job, &Job::byPriority> PriorityList;
+
+static void printQueue(const char* name, const IntrusiveFCFSQueue& queue) {
+    int ids[16];
+    queue.copyTo(ids);
+    std::cout << name << ":";
+    for (int i = 0; i < queue.length(); i++) {
+        std::cout << " " << ids[i];
+    }
+    std::cout << " (length " << queue.length() << ")" << std::endl;
+}
+
+static bool sameEvent(const Event& a, const Event& b) {
+    return a.time == b.time && a.type == b.type && a.patientId == b.patientId && a.resourceId == b.resourceId;
+}
+
+int main() {
+    // part 1: One record, two lists over a plain array
+    Job* jobs = new Job[6];
+    ArrivalList arrival(jobs);
+    PriorityList byPriority(jobs);
+    int priorities[6] = {3, 1, 4, 1, 5, 9};
+    for (int id = 0; id < 6; id++) {
+        jobs[id].priority = priorities[id];
+        arrival.pushBack(id);
+        int before = byPriority.front();
+        while (before != -1 && jobs[before].priority <= priorities[id]) {
+            before = byPriority.next(before);
+        }
+        byPriority.insertBefore(id, before);
+    }
+    arrival.remove(2);
+    byPriority.remove(2);
+    std::cout << "By arrival:";
+    for (int id = arrival.front(); id != -1; id = arrival.next(id)) {
+        std::cout << " " << id;
+    }
+    std::cout << std::endl << "By priority, backward:";
+    for (int id = byPriority.back(); id != -1; id = byPriority.prev(id)) {
+        std::cout << " " << id << "(" << jobs[id].priority << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "Pop front " << arrival.popFront() << ", pop back " << byPriority.popBack() << ", lengths "
+              << arrival.length() << " " << byPriority.length() << std::endl;
+    delete[] jobs;
+
+    // part 2: A queue threaded through the PatientTable
+    PatientTable patients;
+    IntrusiveFCFSQueue triage(patients);
+    IntrusiveFCFSQueue doctor(patients);
+    std::cout << "Empty: " << triage.isEmpty() << ", dequeue " << triage.dequeue() << ", first "
+              << triage.getFirst() << ", last " << triage.getLast() << ", remove back " << triage.removeBack()
+              << std::endl;
+    for (int i = 0; i < 8; i++) {
+        int id = patients.add(i % 3);
+        (i % 2 == 0 ? triage : doctor).enqueue(id);
+    }
+    printQueue("triage", triage);
+    printQueue("doctor", doctor);
+    triage.remove(4);
+    doctor.remove(1);
+    std::cout << "Dequeue " << triage.dequeue() << ", remove back " << doctor.removeBack() << std::endl;
+    triage.enqueue(patients.add(0));
+    printQueue("triage", triage);
+    printQueue("doctor", doctor);
+
+    // the table moves its records when it grows, the links are ids
+    for (int i = 0; i < 200; i++) {
+        patients.add(1);
+    }
+    doctor.enqueue(100);
+    doctor.enqueue(150);
+    printQueue("after growth", doctor);
+    std::cout << "First " << doctor.getFirst() << ", last " << doctor.getLast() << std::endl;
+
+    // part 3: The intrusive sorted list agrees with SortedLinkedList
+    IntrusiveSortedList events;
+    SortedLinkedList reference;
+    std::cout << "Empty: " << events.getFirst() << ", cancel -1: " << events.cancel(-1) << ", cancel 0: "
+              << events.cancel(0) << std::endl;
+    Random rng(11);
+    bool same = true;
+    for (int i = 0; i < 5000; i++) {
+        if (rng.nextInt(2) == 0 || reference.isEmpty()) {
+            Event e(rng.nextInt(40), (EventType)rng.nextInt(8), rng.nextInt(20), rng.nextInt(3) - 1);
+            events.add(e);
+            reference.add(e);
+        }
+        else {
+            same = same && sameEvent(events.removeSmallest(), reference.removeSmallest());
+        }
+        same = same && events.length() == reference.length() && sameEvent(events.getFirst(), reference.getFirst())
+            && sameEvent(events.getLast(), reference.getLast());
+    }
+    while (!reference.isEmpty()) {
+        same = same && sameEvent(events.removeSmallest(), reference.removeSmallest());
+    }
+    std::cout << "Same as SortedLinkedList: " << same << ", empty " << events.isEmpty() << std::endl;
+
+    // part 4: Cancel by handle from the front, the middle and the back
+    int handles[5];
+    for (int i = 0; i < 5; i++) {
+        handles[i] = events.addCancellable(Event(10 * (i % 3), TriageLeave, i, 0));
+    }
+    std::cout << "Cancel " << events.cancel(handles[0]) << " " << events.cancel(handles[4]) << " "
+              << events.cancel(handles[2]) << ", again " << events.cancel(handles[2]) << ", out of range "
+              << events.cancel(1000) << std::endl;
+    int reused = events.addCancellable(Event(15, TriageLeave, 9, 0));
+    std::cout << "Reused handle: " << (reused == handles[2]) << std::endl;
+    while (!events.isEmpty()) {
+        std::cout << events.removeSmallest() << std::endl;
+    }
+
+    // part 5: DES on the intrusive engine prints the heap's trace
+    int arrivalTimes[40];
+    int urgencies[40];
+    for (int i = 0; i < 40; i++) {
+        arrivalTimes[i] = i / 2;
+        urgencies[i] = i % 3;
+    }
+    for (int variant = 0; variant < 2; variant++) {
+        std::ostringstream heapTrace, intrusiveTrace;
+        DES heap(2, 2, 3, 2, 5, 6, 40, urgencies, arrivalTimes, HeapEngine);
+        DES intrusive(2, 2, 3, 2, 5, 6, 40, urgencies, arrivalTimes, IntrusiveListEngine);
+        heap.setOutputStream(heapTrace);
+        intrusive.setOutputStream(intrusiveTrace);
+        // the second run keeps the timers on the event set and cancels them there
+        heap.setTimingWheel(variant == 0);
+        intrusive.setTimingWheel(variant == 0);
+        heap.setCancelBoredomTimers(variant == 1);
+        intrusive.setCancelBoredomTimers(variant == 1);
+        heap.run();
+        intrusive.run();
+        std::cout << (variant == 0 ? "Timing wheel" : "Cancelled timers") << ": same trace "
+                  << (heapTrace.str() == intrusiveTrace.str()) << ", events "
+                  << intrusive.getStatistics().eventsProcessed << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "LinkedList.h"
+#include "Event.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+// compares by key only, the tag tells equal elements apart
+struct Tagged {
+    int key;
+    char tag;
+    Tagged() : key(0), tag('?') {}
+    Tagged(int k, char t) : key(k), tag(t) {}
+    bool operator<(const Tagged& other) const { return key < other.key; }
+};
+
+// counts copies, moves are free
+struct Counted {
+    static int copies;
+    int value;
+    Counted() : value(0) {}
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { copies++; }
+    Counted(Counted&& other) : value(other.value) {}
+    Counted& operator=(const Counted& other)
+    {
+        value = other.value;
+        copies++;
+        return *this;
+    }
+};
+int Counted::copies = 0;
+
+template <typename List>
+static void print(const char* name, const List& list) {
+    std::cout << name << ":";
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it) {
+        std::cout << " " << *it;
+    }
+    std::cout << " (length " << list.length() << ")" << std::endl;
+}
+
+static void printTagged(const char* name, const LinkedList<Tagged>& list) {
+    std::cout << name << ":";
+    for (LinkedList<Tagged>::const_iterator it = list.begin(); it != list.end(); ++it) {
+        std::cout << " " << it->key << it->tag;
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    // part 1: Copies are deep, assignment reuses nodes, self assignment is harmless
+    LinkedList<int> a;
+    for (int i = 1; i <= 4; i++) {
+        a.addBack(i);
+    }
+    LinkedList<int> b(a);
+    b.addBack(5);
+    a.removeFront();
+    print("a", a);
+    print("copy of a", b);
+    b = a;
+    b = b;
+    print("assigned a", b);
+
+    // part 2: Moves take the nodes, the source stays usable
+    LinkedList<int> moved(std::move(b));
+    print("moved", moved);
+    print("moved from", b);
+    b.addBack(42);
+    b = std::move(moved);
+    print("move assigned", b);
+    print("moved from", moved);
+
+    // part 3: Iterators both ways, from end() and with std algorithms
+    std::cout << "Backward:";
+    for (LinkedList<int>::iterator it = b.end(); it != b.begin();) {
+        --it;
+        std::cout << " " << *it;
+    }
+    std::cout << std::endl;
+    for (LinkedList<int>::iterator it = b.begin(); it != b.end(); it++) {
+        *it *= 10;
+    }
+    print("times ten", b);
+    std::cout << "Find 30: " << (std::find(b.begin(), b.end(), 30) != b.end())
+              << ", count of 7: " << std::count(b.begin(), b.end(), 7) << std::endl;
+
+    // part 4: Emplace builds elements in place, moves and removes do not copy
+    LinkedList<Event> events;
+    events.emplaceBack(20, TriageLeave, 3, 1);
+    events.emplaceFront(10, TriageQueueEntrance, 3, -1);
+    LinkedList<Event>::const_iterator second = events.begin();
+    ++second;
+    events.emplace(second, 15, TriageEntrance, 3, 1);
+    events.emplace(events.end(), 30, DoctorQueueEntrance, 3, -1);
+    for (LinkedList<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        std::cout << *it << std::endl;
+    }
+    LinkedList<Counted> counted;
+    for (int i = 0; i < 100; i++) {
+        counted.emplaceBack(i);
+        counted.addFront(Counted(-i));
+    }
+    long sum = 0;
+    while (!counted.isEmpty()) {
+        sum += counted.removeFront().value + counted.removeBack().value;
+    }
+    std::cout << "Counted sum " << sum << ", copies " << Counted::copies << std::endl;
+    LinkedList<std::unique_ptr<int> > owners;
+    owners.emplaceBack(new int(7));
+    owners.addFront(std::unique_ptr<int>(new int(6)));
+    std::unique_ptr<int> first = owners.removeFront();
+    std::cout << "Move only: " << *first << " " << **owners.begin() << ", length " << owners.length() << std::endl;
+
+    // part 5: Splice moves whole lists in front of any position
+    LinkedList<int> x, y, z;
+    for (int i = 0; i < 3; i++) {
+        x.addBack(i);
+        y.addBack(100 + i);
+        z.addBack(200 + i);
+    }
+    LinkedList<int>::iterator at = x.begin();
+    ++at;
+    x.splice(at, y);
+    x.splice(x.begin(), z);
+    print("spliced", x);
+    print("y", y);
+    x.splice(x.end(), y);
+    x.splice(x.begin(), x);
+    print("nothing spliced", x);
+    {
+        LinkedList<int> temporary;
+        for (int i = 0; i < 50; i++) {
+            temporary.addBack(300 + i);
+        }
+        x.splice(x.end(), temporary);
+        temporary.addBack(1);
+    }
+    // the spliced nodes outlive the list that made them
+    int total = 0;
+    while (!x.isEmpty()) {
+        total += x.removeBack();
+    }
+    std::cout << "Total after the source is gone: " << total << std::endl;
+
+    // part 6: Merge is stable, equal keys of this list go first
+    LinkedList<Tagged> left, right, empty;
+    int leftKeys[5] = {1, 3, 3, 7, 9};
+    int rightKeys[6] = {0, 3, 4, 7, 10, 11};
+    for (int i = 0; i < 5; i++) {
+        left.addBack(Tagged(leftKeys[i], 'a'));
+    }
+    for (int i = 0; i < 6; i++) {
+        right.addBack(Tagged(rightKeys[i], 'b'));
+    }
+    left.merge(right);
+    printTagged("merged", left);
+    std::cout << "Right empty: " << right.isEmpty() << ", last " << left.getBack().key
+              << ", back from end " << (--left.end())->key << std::endl;
+    empty.merge(left);
+    printTagged("into empty", empty);
+    empty.merge(left);
+    empty.merge(empty);
+    std::cout << "Length " << empty.length() << ", left empty " << left.isEmpty() << std::endl;
+    return 0;
+}
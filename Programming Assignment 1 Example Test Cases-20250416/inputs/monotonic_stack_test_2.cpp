@@ -0,0 +1,26 @@
+#include "MonotonicStack.h"
+#include <iostream>
+
+int main() {
+    MonotonicStack ms;
+
+    // Test Case 1: A stack taller than one list node keeps its order
+    for (int i = 0; i < 60; i++) {
+        ms.push(i);
+    }
+    std::cout << "Stack: " << ms << std::endl;
+
+    // Test Case 2: A small id cuts across node boundaries
+    ms.push(20);
+    std::cout << "Stack: " << ms << std::endl;
+    std::cout << "Top: " << ms.top() << std::endl;
+
+    // Test Case 3: Pop everything
+    while (!ms.isEmpty()) {
+        ms.pop();
+    }
+    std::cout << "Stack: " << ms << std::endl;
+    std::cout << "Is stack empty? " << ms.isEmpty() << std::endl;
+
+    return 0;
+}
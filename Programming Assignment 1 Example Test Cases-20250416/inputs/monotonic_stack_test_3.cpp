@@ -0,0 +1,65 @@
+#include "MonotonicStack.h"
+#include "Random.h"
+#include <iostream>
+
+int main() {
+    MonotonicStack ms;
+
+    // Test Case 1: Empty stack answers 0
+    std::cout << "Stack: " << ms << ", top " << ms.top() << ", pop " << ms.pop() << std::endl;
+
+    // Test Case 2: A push cuts at the first larger id, equal ids stay
+    int ids[8] = {1, 3, 5, 5, 7, 9, 11, 13};
+    for (int i = 0; i < 8; i++) {
+        ms.push(ids[i]);
+    }
+    std::cout << "Stack: " << ms << std::endl;
+    ms.push(5);
+    std::cout << "After push(5): " << ms << ", length " << ms.length() << std::endl;
+    ms.push(0);
+    std::cout << "After push(0): " << ms << std::endl;
+
+    // Test Case 3: pushRange is one push after another
+    int range[7] = {4, 8, 6, 6, 10, 2, 3};
+    MonotonicStack batch, single;
+    for (int i = 0; i < 8; i++) {
+        batch.push(ids[i]);
+        single.push(ids[i]);
+    }
+    batch.pushRange(range, 7);
+    for (int i = 0; i < 7; i++) {
+        single.push(range[i]);
+    }
+    std::cout << "pushRange: " << batch << std::endl;
+    std::cout << "push each: " << single << std::endl;
+    batch.pushRange(range, 0);
+    std::cout << "Empty range: " << batch << std::endl;
+
+    // Test Case 4: Random ranges agree with single pushes
+    Random rng(3);
+    MonotonicStack a, b;
+    int values[64];
+    bool same = true;
+    for (int round = 0; round < 2000 && same; round++) {
+        int n = rng.nextInt(64);
+        for (int i = 0; i < n; i++) {
+            values[i] = rng.nextInt(1000) + round;
+        }
+        a.pushRange(values, n);
+        for (int i = 0; i < n; i++) {
+            b.push(values[i]);
+        }
+        same = a.length() == b.length();
+        int* x = new int[a.length() + 1];
+        int* y = new int[b.length() + 1];
+        a.copyTo(x);
+        b.copyTo(y);
+        for (int i = 0; i < a.length() && same; i++) {
+            same = x[i] == y[i];
+        }
+        delete[] x;
+        delete[] y;
+    }
+    std::cout << "Random ranges same: " << same << ", length " << a.length() << ", top " << a.top() << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include "DES.h"
+#include "FCFSQueue.h"
+#include "MonotonicStack.h"
+#include "SortedLinkedList.h"
+#include "TieredFCFSQueue.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// every heap allocation of the program goes through here.
+static long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    allocations++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// swallows the DES trace without allocating, counts lines as events.
+class CountingBuffer : public std::streambuf {
+public:
+    long lines;
+    CountingBuffer() : lines(0) {}
+protected:
+    int overflow(int c)
+    {
+        if (c == '\n') {
+            lines++;
+        }
+        return c;
+    }
+};
+
+int main() {
+    // part 1: LinkedList at a steady size reuses its nodes
+    LinkedList<int> list;
+    for (int i = 0; i < 100; i++) {
+        list.addBack(i);
+    }
+    long before = allocations;
+    for (int i = 0; i < 100000; i++) {
+        list.addBack(list.removeFront());
+        list.addFront(list.removeBack());
+    }
+    std::cout << "LinkedList steady state allocations: " << allocations - before << std::endl;
+
+    // part 2: Hold model on the sorted list
+    SortedLinkedList sorted;
+    for (int i = 0; i < 200; i++) {
+        sorted.add(Event(i * 7 % 200, TriageLeave, i, 0));
+    }
+    before = allocations;
+    for (int i = 0; i < 100000; i++) {
+        Event e = sorted.removeSmallest();
+        sorted.add(Event(e.time + 1 + i % 200, TriageLeave, e.patientId, 0));
+    }
+    std::cout << "SortedLinkedList steady state allocations: " << allocations - before << std::endl;
+
+    // part 3: Queues and stacks going up and down
+    FCFSQueue queue;
+    TieredFCFSQueue tiered(4);
+    MonotonicStack stack;
+    for (int round = 0; round < 2; round++) {
+        if (round == 1) {
+            before = allocations;
+        }
+        for (int i = 0; i < 50000; i++) {
+            queue.enqueue(i);
+            tiered.enqueue(i, i % 4);
+            stack.push(i % 64);
+            if (i % 64 == 63) {
+                while (!stack.isEmpty()) {
+                    stack.pop();
+                }
+            }
+            if (i % 8 == 7) {
+                for (int j = 0; j < 8; j++) {
+                    queue.dequeue();
+                    tiered.dequeue();
+                }
+            }
+        }
+    }
+    std::cout << "Queue and stack steady state allocations: " << allocations - before << std::endl;
+
+    // part 4: DES::run allocates with the growth of the data, not per event.
+    // A first run warms up the stream and everything else outside DES, the
+    // second, identical one is counted. Its 59 allocations are 44 growths
+    // of the doctor stacks (4 doctors, 16 -> 3652 bytes each), 12 of the
+    // triage and doctor queues and 3 of the timing wheel, every one a
+    // structure reaching a new peak size.
+    // static, so main itself has no new[]/delete[] pair for GCC to
+    // match against the replacements above.
+    const int numPatients = 4096;
+    static int arrivals[numPatients];
+    static int urgencies[numPatients];
+    for (int i = 0; i < numPatients; i++) {
+        arrivals[i] = i / 2;
+        urgencies[i] = i % 3;
+    }
+    CountingBuffer trace;
+    std::streambuf* saved = std::cout.rdbuf(&trace);
+    long runAllocations[2];
+    for (int run = 0; run < 2; run++) {
+        DES sim(2, 4, 3, 1, 3, 5, numPatients, urgencies, arrivals);
+        before = allocations;
+        sim.run();
+        runAllocations[run] = allocations - before;
+    }
+    std::cout.rdbuf(saved);
+
+    std::cout << "DES events: " << trace.lines / 2 << std::endl;
+    std::cout << "DES::run allocations: " << runAllocations[1] << ", same as the warm up run: "
+              << (runAllocations[0] == runAllocations[1]) << std::endl;
+
+    return 0;
+}
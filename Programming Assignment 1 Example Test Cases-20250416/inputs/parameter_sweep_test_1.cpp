@@ -0,0 +1,39 @@
+#include <iostream>
+#include <sstream>
+#include "ParameterSweep.h"
+
+int main() {
+    // part 1: CSV dataset, header and comments are skipped
+    std::istringstream csv("arrival,urgency\n1,1\n2,2\n# late ones\n4,0\n6, 1\n8,2\n\n");
+    PatientDataset data;
+    std::cout << "Bad line: " << data.loadCsv(csv) << std::endl;
+    std::cout << "Patients: " << data.size() << ", max urgency: " << data.maxUrgency() << std::endl;
+
+    std::istringstream broken("1,1\n2;2\n");
+    PatientDataset other;
+    std::cout << "Bad line: " << other.loadCsv(broken) << std::endl;
+
+    // values have to fit an int, urgencies can not be negative
+    const char* edges[5] = {"1,1\n-2147483648,0\n2147483647,2147483647\n", "1,1\n2147483648,1\n",
+                            "1,1\n-2147483649,1\n", "1,1\n4294967297,1\n", "1,1\n2,-1\n"};
+    for (int i = 0; i < 5; i++) {
+        std::istringstream in(edges[i]);
+        PatientDataset edge;
+        int bad = edge.loadCsv(in);
+        std::cout << "Edge " << i << " bad line: " << bad << ", patients: " << edge.size();
+        if (bad == 0) {
+            std::cout << ", last " << edge.arrivalTimes()[edge.size() - 1] << "," << edge.maxUrgency();
+        }
+        std::cout << std::endl;
+    }
+
+    // part 2: des_test_3 with 1-2 triages, 1-2 doctors and 2-3 tiers. The
+    // point 2,2,3 is des_test_3 itself. With 2 tiers urgency 2 joins tier 1.
+    SweepGrid grid = {{1, 2, 1}, {1, 2, 1}, {2, 3, 1}, {3, 3, 0}, {4, 4, 0}, {5, 5, 0}};
+    ParameterSweep sweep(data, grid);
+    sweep.setThreads(3);
+    sweep.run();
+    std::cout << "Points: " << sweep.pointCount() << std::endl;
+    sweep.writeCsv(std::cout);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "RadixHeap.h"
+#include <iostream>
+
+int main() {
+    RadixHeap heap;
+
+    // part 1: Empty heap
+    std::cout << "Is heap empty? " << heap.isEmpty() << std::endl;
+
+    // part 2: Ties on time are broken by patientId, type and resourceId
+    heap.add(Event(7, DoctorEntrance, 2, 1));
+    heap.add(Event(7, DoctorEntrance, 2, 0));
+    heap.add(Event(7, TriageLeave, 2, 1));
+    heap.add(Event(7, DoctorEntrance, 1, 3));
+    heap.add(Event(40, TriageQueueEntrance, 0, -1));
+    heap.add(Event(9, TriageEntrance, 6, 0));
+    std::cout << "Heap length: " << heap.length() << std::endl;
+    std::cout << "First: " << heap.getFirst() << std::endl;
+    std::cout << "Last: " << heap.getLast() << std::endl;
+
+    // part 3: Monotone use, new events never go before the last removed one
+    for (int i = 0; i < 3; i++) {
+        Event e = heap.removeSmallest();
+        std::cout << e << std::endl;
+        heap.add(Event(e.time + 3, PatientLeaveHospital, e.patientId, e.resourceId));
+    }
+    std::cout << "First: " << heap.getFirst() << std::endl;
+
+    // part 4: An event before the last removed one still comes out first
+    heap.add(Event(-5, TriageQueueEntrance, 9, -1));
+    while (!heap.isEmpty()) {
+        std::cout << heap.removeSmallest() << std::endl;
+    }
+    std::cout << "Is heap empty? " << heap.isEmpty() << std::endl;
+
+    return 0;
+}
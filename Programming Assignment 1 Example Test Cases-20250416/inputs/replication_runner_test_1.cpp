@@ -0,0 +1,60 @@
+#include <iostream>
+#include <sstream>
+#include "ReplicationRunner.h"
+
+static bool sameStatistics(const DESStatistics& a, const DESStatistics& b) {
+    return a.eventsProcessed == b.eventsProcessed && a.patientsTreated == b.patientsTreated
+        && a.patientsBored == b.patientsBored && a.finishTime == b.finishTime;
+}
+
+int main() {
+    // numTriages, numDoctors, numTiers, triage, doctor, boring, patients, mean interarrival
+    HospitalScenario scenario = {2, 3, 3, 3, 8, 12, 200, 2};
+    const int N = 6;
+
+    ReplicationRunner serial(scenario, N, 2025);
+    serial.setThreads(1);
+    std::ostringstream serialTraces[N];
+    std::ostream* serialStreams[N];
+    for (int i = 0; i < N; i++) {
+        serialStreams[i] = &serialTraces[i];
+    }
+    serial.setTraceStreams(serialStreams);
+    serial.run();
+
+    ReplicationRunner parallel(scenario, N, 2025);
+    parallel.setThreads(3);
+    std::ostringstream parallelTraces[N];
+    std::ostream* parallelStreams[N];
+    for (int i = 0; i < N; i++) {
+        parallelStreams[i] = &parallelTraces[i];
+    }
+    parallel.setTraceStreams(parallelStreams);
+    parallel.run();
+
+    // part 1: Every replication is the same on 1 and on 3 threads
+    for (int i = 0; i < N; i++) {
+        const DESStatistics& r = parallel.getResult(i);
+        std::cout << "Replication " << i << ": events " << r.eventsProcessed << ", treated " << r.patientsTreated
+                  << ", bored " << r.patientsBored << ", finish " << r.finishTime
+                  << ", same stats " << sameStatistics(r, serial.getResult(i))
+                  << ", same trace " << (parallelTraces[i].str() == serialTraces[i].str()) << std::endl;
+    }
+
+    // part 2: Streams of one seed are different, the trace has every patient
+    std::cout << "Replications 0 and 1 differ: " << (serialTraces[0].str() != serialTraces[1].str()) << std::endl;
+    const DESStatistics& first = serial.getResult(0);
+    std::cout << "Treated + bored: " << first.patientsTreated + first.patientsBored << std::endl;
+
+    // part 3: Merged summary, traces dropped
+    ReplicationRunner quiet(scenario, N, 2025);
+    quiet.setThreads(2);
+    quiet.run();
+    ReplicationSummary s = quiet.summarize();
+    std::cout << "Replications: " << s.replications << ", events " << s.eventsProcessed
+              << ", treated " << s.patientsTreated << ", bored " << s.patientsBored << std::endl;
+    std::cout << "Mean treated: " << s.meanTreated << ", mean bored: " << s.meanBored
+              << ", mean finish: " << s.meanFinishTime << std::endl;
+    std::cout << "Finish time range: " << s.minFinishTime << " " << s.maxFinishTime << std::endl;
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "ResourcePool.h"
+#include <iostream>
+
+int main() {
+    // part 1: Lowest free id first
+    ResourcePool doctors(200);
+    std::cout << "Size: " << doctors.size() << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+
+    // part 2: A released id is handed out again before higher ones
+    doctors.release(1);
+    std::cout << "Is 1 available? " << doctors.isAvailable(1) << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+
+    // part 3: Taking a specific id
+    std::cout << "Acquire 150: " << doctors.acquire(150) << std::endl;
+    std::cout << "Acquire 150 again: " << doctors.acquire(150) << std::endl;
+
+    // part 4: Everyone busy
+    int last = -1;
+    while (doctors.hasAvailable()) {
+        last = doctors.acquire();
+    }
+    std::cout << "Last acquired: " << last << std::endl;
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+    doctors.release(70);
+    std::cout << "Acquire: " << doctors.acquire() << std::endl;
+
+    // part 5: No resources at all
+    ResourcePool none(0);
+    std::cout << "Acquire from empty pool: " << none.acquire() << std::endl;
+
+    return 0;
+}
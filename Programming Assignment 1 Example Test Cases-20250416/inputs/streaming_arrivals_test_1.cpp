@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "DES.h"
+#include "MappedArrivalFile.h"
+
+// one patient every 2 time units, urgency cycling over 3 tiers
+class SteadyArrivals : public ArrivalSource {
+public:
+    int left;
+    int time;
+    SteadyArrivals(int n) : left(n), time(0) {}
+    bool next(int& arrivalTime, int& urgencyLevel) {
+        if (left == 0) {
+            return false;
+        }
+        arrivalTime = time;
+        urgencyLevel = left % 3;
+        time += 2;
+        left--;
+        return true;
+    }
+};
+
+int main() {
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+
+    // part 1: des_test_3 streamed from a CSV file
+    {
+        std::ofstream csv("streaming_arrivals_test_1.csv");
+        csv << "arrival,urgency\n";
+        for (int i = 0; i < 5; i++) {
+            csv << arrival_times[i] << "," << urgency_levels[i] << "\n";
+        }
+    }
+    MappedArrivalFile csvFile("streaming_arrivals_test_1.csv");
+    std::cout << "CSV open: " << csvFile.isOpen() << std::endl;
+    std::ostringstream csvTrace;
+    {
+        DES sim(2, 2, 3, 3, 4, 5, csvFile, HeapEngine);
+        sim.setOutputStream(csvTrace);
+        sim.run();
+        std::cout << "Peak patients: " << sim.getStatistics().peakPatients << std::endl;
+    }
+    std::cout << csvTrace.str();
+
+    // part 2: The same patients from a binary file and from the arrays
+    {
+        std::ofstream bin("streaming_arrivals_test_1.bin", std::ios::binary);
+        MappedArrivalFile::writeBinaryHeader(bin);
+        for (int i = 0; i < 5; i++) {
+            MappedArrivalFile::writeBinaryRecord(bin, arrival_times[i], urgency_levels[i]);
+        }
+    }
+    MappedArrivalFile binFile("streaming_arrivals_test_1.bin");
+    std::ostringstream binTrace;
+    {
+        DES sim(2, 2, 3, 3, 4, 5, binFile, RadixEngine);
+        sim.setOutputStream(binTrace);
+        sim.run();
+    }
+    std::cout << "Binary trace same: " << (binTrace.str() == csvTrace.str()) << std::endl;
+    std::ostringstream arrayTrace;
+    {
+        DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+        sim.setOutputStream(arrayTrace);
+        sim.run();
+    }
+    std::cout << "Array trace same: " << (arrayTrace.str() == csvTrace.str()) << std::endl;
+
+    // part 3: Memory follows the patients inside, not all that came
+    SteadyArrivals steady(200000);
+    std::ostream discard(NULL);
+    DES sim(1, 2, 3, 1, 3, 10, steady, HeapEngine);
+    sim.setOutputStream(discard);
+    sim.run();
+    const DESStatistics& stats = sim.getStatistics();
+    std::cout << "Treated + bored: " << stats.patientsTreated + stats.patientsBored << std::endl;
+    std::cout << "Peak patients below 100: " << (stats.peakPatients < 100) << std::endl;
+
+    // part 4: A malformed line ends the stream
+    {
+        std::ofstream csv("streaming_arrivals_test_1.csv");
+        csv << "1,0\n2,1\n3;2\n4,0\n";
+    }
+    MappedArrivalFile broken("streaming_arrivals_test_1.csv");
+    int t, u, n = 0;
+    while (broken.next(t, u)) {
+        n++;
+    }
+    std::cout << "Read: " << n << ", error line: " << broken.errorLine() << std::endl;
+    // past INT_MAX is an error, -2147483648 still fits
+    {
+        std::ofstream csv("streaming_arrivals_test_1.csv");
+        csv << "-2147483648,0\n2147483647,1\n2147483648,2\n";
+    }
+    MappedArrivalFile edges("streaming_arrivals_test_1.csv");
+    n = 0;
+    while (edges.next(t, u)) {
+        std::cout << "Edge arrival " << t << ", urgency " << u << std::endl;
+        n++;
+    }
+    std::cout << "Read: " << n << ", error line: " << edges.errorLine() << std::endl;
+    MappedArrivalFile missing("streaming_arrivals_test_1.none");
+    std::cout << "Missing open: " << missing.isOpen() << std::endl;
+
+    std::remove("streaming_arrivals_test_1.csv");
+    std::remove("streaming_arrivals_test_1.bin");
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "TieredFCFSQueue.h"
+#include "OccupancyBitmap.h"
+#include <iostream>
+
+int main() {
+
+    // part 1: Bitmap edges, word and summary boundaries
+    OccupancyBitmap bitmap(5000);
+    std::cout << "Bitmap empty: " << bitmap.isEmpty() << ", first: " << bitmap.findFirst() << ", last: " << bitmap.findLast() << std::endl;
+    bitmap.set(63);
+    bitmap.set(64);
+    bitmap.set(4095);
+    bitmap.set(4096);
+    bitmap.set(4999);
+    bitmap.set(5000); // out of range, ignored
+    std::cout << "Bitmap first: " << bitmap.findFirst() << ", last: " << bitmap.findLast() << std::endl;
+    bitmap.clear(63);
+    bitmap.clear(4999);
+    std::cout << "Bitmap first: " << bitmap.findFirst() << ", last: " << bitmap.findLast() << std::endl;
+    bitmap.clear(64);
+    bitmap.clear(4095);
+    bitmap.clear(4096);
+    std::cout << "Bitmap empty: " << bitmap.isEmpty() << std::endl;
+
+    // part 2: Thousands of tiers
+    TieredFCFSQueue queue(5000);
+    std::cout << "Is queue empty? " << queue.isEmpty() << std::endl;
+    queue.enqueue(7, 4321);
+    queue.enqueue(8, 65);
+    queue.enqueue(9, 4999);
+    queue.enqueue(10, 65);
+    queue.enqueue(11, 5000); // no such tier
+    std::cout << "First: " << queue.getFirst() << ", last: " << queue.getLast() << std::endl;
+
+    // part 3: Leaving from the back of a single tier
+    std::cout << "Last of tier 65: " << queue.getLast(65) << std::endl;
+    std::cout << "Remove back of tier 65: " << queue.removeBack(65) << std::endl;
+    std::cout << "Remove back of tier 4999: " << queue.removeBack(4999) << std::endl;
+    std::cout << "Remove back of tier 4999: " << queue.removeBack(4999) << std::endl;
+    std::cout << "Last: " << queue.getLast() << std::endl;
+
+    // part 4: Drain in tier order
+    std::cout << "Dequeue: " << queue.dequeue() << std::endl;
+    std::cout << "Dequeue: " << queue.dequeue() << std::endl;
+    std::cout << "Dequeue: " << queue.dequeue() << std::endl;
+    std::cout << "Is queue empty? " << queue.isEmpty() << std::endl;
+
+    return 0;
+}
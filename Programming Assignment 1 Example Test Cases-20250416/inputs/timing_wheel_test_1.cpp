@@ -0,0 +1,36 @@
+#include "TimingWheel.h"
+#include <iostream>
+
+int main() {
+    TimingWheel wheel;
+
+    // part 1: Empty wheel
+    std::cout << "Is wheel empty? " << wheel.isEmpty() << std::endl;
+
+    // part 2: Timers at the same time come out in Event::operator< order
+    wheel.schedule(Event(10, DoctorQueueBoringStart, 4, -1));
+    wheel.schedule(Event(10, TriageQueueBoringStart, 4, -1));
+    wheel.schedule(Event(10, TriageQueueBoringStart, 1, -1));
+    int late = wheel.schedule(Event(300, TriageQueueBoringStart, 2, -1));
+    wheel.schedule(Event(70000, DoctorQueueBoringStart, 3, -1)); // needs two cascades
+    wheel.schedule(Event(12, DoctorQueueBoringStart, 5, -1));
+    std::cout << "Wheel length: " << wheel.length() << std::endl;
+    std::cout << "First: " << wheel.getFirst() << std::endl;
+
+    // part 3: Cancel, also a timer already due and one already cancelled
+    std::cout << "Cancel 300: " << wheel.cancel(late) << std::endl;
+    std::cout << "Cancel 300 again: " << wheel.cancel(late) << std::endl;
+    int dueNow = wheel.schedule(Event(10, DoctorQueueBoringStart, 0, -1));
+    std::cout << "First: " << wheel.getFirst() << std::endl;
+    std::cout << "Cancel due timer: " << wheel.cancel(dueNow) << std::endl;
+    std::cout << "Wheel length: " << wheel.length() << std::endl;
+
+    // part 4: A timer before the current time still comes out first
+    wheel.schedule(Event(-3, TriageQueueBoringStart, 9, -1));
+    while (!wheel.isEmpty()) {
+        std::cout << wheel.removeSmallest() << std::endl;
+    }
+    std::cout << "Removed from empty: " << wheel.removeSmallest() << std::endl;
+    std::cout << "Cancel bad handle: " << wheel.cancel(-1) << std::endl;
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include <iostream>
+#include <climits>
+#include "BufferedTraceSink.h"
+#include "DES.h"
+
+int main() {
+    // part 1: Hand formatted numbers match the stream operator
+    {
+        BufferedTraceSink sink(std::cout);
+        sink.event(Event(0, TriageQueueEntrance, 0, -1));
+        sink.event(Event(INT_MAX, DoctorQueueBoringStart, INT_MIN, 1000000007));
+        sink.event(Event(-42, PatientLeaveHospital, 9, -1));
+        MonotonicStack stack;
+        sink.doctorStack(3, stack);
+        stack.push(12);
+        stack.push(4);
+        sink.doctorStack(4, stack);
+        sink.flush();
+    }
+    std::cout << Event(INT_MAX, DoctorQueueBoringStart, INT_MIN, 1000000007) << std::endl;
+
+    // part 2: des_test_3 through a tiny buffer, so the writer thread gets
+    // a buffer every line or two. The trace must not change.
+    int arrival_times[5] = {1, 2, 4, 6, 8};
+    int urgency_levels[5] = {1, 2, 0, 1, 2};
+    DES sim(2, 2, 3, 3, 4, 5, 5, urgency_levels, arrival_times);
+    BufferedTraceSink sink(std::cout, 100);
+    sim.setTraceSink(sink);
+    sim.run();
+    std::cout << "After run." << std::endl;
+    return 0;
+}
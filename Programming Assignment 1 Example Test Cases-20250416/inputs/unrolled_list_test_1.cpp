@@ -0,0 +1,57 @@
+#include "UnrolledLinkedList.h"
+#include "LinkedList.h"
+#include "Event.h"
+#include <iostream>
+
+int main() {
+    UnrolledLinkedList<Event> list;
+
+    // part 1: Empty list
+    std::cout << "Is list empty? " << list.isEmpty() << std::endl;
+    std::cout << "List length: " << list.length() << std::endl;
+    std::cout << "Remove front of empty list: " << list.removeFront() << std::endl;
+
+    // part 2: Add to front and back
+    list.addFront(Event(10, DoctorEntrance, 5, 1));
+    list.addBack(Event(20, TriageQueueEntrance, 10, -1));
+    list.addFront(Event(30, PatientLeaveHospital, 3, 2));
+    std::cout << "List length: " << list.length() << std::endl;
+    std::cout << "Front: " << list.getFront() << std::endl;
+    std::cout << "Back: " << list.getBack() << std::endl;
+    std::cout << "Remove front: " << list.removeFront() << std::endl;
+    std::cout << "Remove back: " << list.removeBack() << std::endl;
+    std::cout << "Remove front: " << list.removeFront() << std::endl;
+    std::cout << "Is list empty? " << list.isEmpty() << std::endl;
+
+    // part 3: Many node boundaries, same answers as LinkedList
+    UnrolledLinkedList<int> unrolled;
+    LinkedList<int> reference;
+    bool same = true;
+    for (int i = 0; i < 5000; i++) {
+        int op = (i * 7 + i / 13) % 6;
+        if (op == 0 || op == 1) {
+            unrolled.addBack(i);
+            reference.addBack(i);
+        }
+        else if (op == 2 || op == 3) {
+            unrolled.addFront(i);
+            reference.addFront(i);
+        }
+        else if (op == 4) {
+            same = same && unrolled.removeFront() == reference.removeFront();
+        }
+        else {
+            same = same && unrolled.removeBack() == reference.removeBack();
+        }
+        same = same && unrolled.length() == reference.length();
+        same = same && unrolled.getFront() == reference.getFront() && unrolled.getBack() == reference.getBack();
+    }
+    std::cout << "Length after mixed operations: " << unrolled.length() << std::endl;
+    while (!reference.isEmpty()) {
+        same = same && unrolled.removeBack() == reference.removeBack();
+    }
+    std::cout << "Same as LinkedList? " << same << std::endl;
+    std::cout << "Is list empty? " << unrolled.isEmpty() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <sstream>
+#include "DES.h"
+#include "MappedArrivalFile.h"
+#include "WorkloadGenerator.h"
+
+int main() {
+    // part 1: Same seed and stream, same patients. Other streams differ.
+    double weights[3] = {0.2, 0.3, 0.5};
+    WorkloadGenerator a(7), b(7), c(7, 1);
+    a.setArrivalRate(0.5);
+    b.setArrivalRate(0.5);
+    c.setArrivalRate(0.5);
+    a.setUrgencyWeights(weights, 3);
+    b.setUrgencyWeights(weights, 3);
+    c.setUrgencyWeights(weights, 3);
+    int sameAsB = 0, sameAsC = 0;
+    for (int i = 0; i < 1000; i++) {
+        int ta, ua, tb, ub, tc, uc;
+        a.next(ta, ua);
+        b.next(tb, ub);
+        c.next(tc, uc);
+        sameAsB += (ta == tb && ua == ub);
+        sameAsC += (ta == tc && ua == uc);
+    }
+    std::cout << "Same seed: " << sameAsB << "/1000, other stream: " << (sameAsC < 1000) << std::endl;
+
+    // part 2: Poisson rate and urgency shares of 200000 patients
+    WorkloadGenerator poisson(11);
+    poisson.setArrivalRate(2.0);
+    poisson.setUrgencyWeights(weights, 3);
+    int tiers[3] = {0, 0, 0};
+    int t, u, last = 0;
+    bool sorted = true;
+    for (int i = 0; i < 200000; i++) {
+        poisson.next(t, u);
+        sorted = sorted && t >= last;
+        last = t;
+        tiers[u]++;
+    }
+    double observedRate = 200000.0 / last;
+    std::cout << "Sorted: " << sorted << ", rate near 2: " << (observedRate > 1.98 && observedRate < 2.02) << std::endl;
+    for (int i = 0; i < 3; i++) {
+        double share = tiers[i] / 200000.0;
+        std::cout << "Tier " << i << " share near " << weights[i] << ": "
+                  << (share > weights[i] - 0.01 && share < weights[i] + 0.01) << std::endl;
+    }
+
+    // part 3: A day of 100 units, closed for the first quarter, busy at midday
+    double day[4] = {0.0, 1.0, 3.0, 1.0};
+    WorkloadGenerator daily(3);
+    std::cout << "Bad profile: " << daily.setDailyProfile(100, day, 0) << std::endl;
+    std::cout << "Profile: " << daily.setDailyProfile(100, day, 4) << std::endl;
+    daily.setArrivalRate(1.0);
+    daily.setEndTime(100000);
+    int perSlot[4] = {0, 0, 0, 0};
+    while (daily.next(t, u)) {
+        perSlot[(t % 100) / 25]++;
+    }
+    std::cout << "Closed slot: " << perSlot[0] << std::endl;
+    std::cout << "Midday about 3x: " << (perSlot[2] > 2.8 * perSlot[1] && perSlot[2] < 3.2 * perSlot[1]) << std::endl;
+    std::cout << "Total near 125000: " << (perSlot[1] + perSlot[2] + perSlot[3] > 123000
+                                          && perSlot[1] + perSlot[2] + perSlot[3] < 127000) << std::endl;
+
+    // part 4: Bursts only, 40 critical patients over 10 time units each
+    double critical[3] = {1.0, 0.0, 0.0};
+    WorkloadGenerator bursts(5);
+    bursts.setArrivalRate(0.0);
+    bursts.setBursts(0.001, 40, 10);
+    bursts.setUrgencyWeights(weights, 3);
+    std::cout << "Bad weights: " << bursts.setBurstUrgencyWeights(weights, 0) << std::endl;
+    bursts.setBurstUrgencyWeights(critical, 3);
+    bursts.setPatientLimit(400);
+    int count = 0, urgent = 0, first = -1, atFirst = 0;
+    while (bursts.next(t, u)) {
+        if (first == -1) {
+            first = t;
+        }
+        atFirst += (t < first + 10);
+        count++;
+        urgent += (u == 0);
+    }
+    std::cout << "Burst patients: " << count << ", critical: " << urgent
+              << ", in the first burst: " << atFirst << std::endl;
+
+    // part 5: Arrays filled for DES give the same run as streaming
+    WorkloadGenerator forArrays(9), forStream(9);
+    forArrays.setArrivalRate(0.25);
+    forStream.setArrivalRate(0.25);
+    forArrays.setUrgencyWeights(weights, 3);
+    forStream.setUrgencyWeights(weights, 3);
+    forStream.setPatientLimit(2000);
+    int arrivals[2000], urgencies[2000];
+    std::cout << "Generated: " << forArrays.generate(arrivals, urgencies, 2000) << std::endl;
+    std::ostringstream arrayTrace, streamTrace;
+    {
+        DES sim(2, 3, 3, 3, 8, 20, 2000, urgencies, arrivals);
+        sim.setOutputStream(arrayTrace);
+        sim.run();
+        std::cout << "Treated + bored: " << sim.getStatistics().patientsTreated + sim.getStatistics().patientsBored << std::endl;
+    }
+    {
+        DES sim(2, 3, 3, 3, 8, 20, forStream);
+        sim.setOutputStream(streamTrace);
+        sim.run();
+    }
+    std::cout << "Same trace: " << (arrayTrace.str() == streamTrace.str()) << std::endl;
+
+    // part 6: Files MappedArrivalFile reads back
+    WorkloadGenerator toCsv(13), toBinary(13);
+    std::ostringstream csv, binary;
+    std::cout << "CSV written: " << toCsv.writeCsv(csv, 5) << std::endl;
+    std::cout << csv.str();
+    std::cout << "Binary written: " << toBinary.writeBinary(binary, 5) << ", bytes: " << binary.str().size() << std::endl;
+    return 0;
+}
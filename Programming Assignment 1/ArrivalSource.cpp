@@ -0,0 +1,20 @@
+#include "ArrivalSource.h"
+
+ArrayArrivalSource::ArrayArrivalSource(const int* arrivalTimes, const int* urgencyLevels, int numPatients)
+{
+    arrivals = arrivalTimes;
+    urgencies = urgencyLevels;
+    count = numPatients;
+    position = 0;
+}
+
+bool ArrayArrivalSource::next(int& arrivalTime, int& urgencyLevel)
+{
+    if (position >= count) {
+        return false;
+    }
+    arrivalTime = arrivals[position];
+    urgencyLevel = urgencies[position];
+    position++;
+    return true;
+}
@@ -0,0 +1,26 @@
+#ifndef ARRIVALSOURCE_H
+#define ARRIVALSOURCE_H
+
+// Patients in arrival order, read by DES one at a time as the simulation
+// reaches them. Patient ids are given in the order patients are read.
+class ArrivalSource {
+public:
+    virtual ~ArrivalSource() {}
+    // the next patient, false when there are no more
+    virtual bool next(int& arrivalTime, int& urgencyLevel) = 0;
+};
+
+// Arrays the caller already has. They are read, not copied.
+class ArrayArrivalSource : public ArrivalSource {
+private:
+    const int* arrivals;
+    const int* urgencies;
+    int count;
+    int position;
+
+public:
+    ArrayArrivalSource(const int* arrivalTimes, const int* urgencyLevels, int numPatients);
+    bool next(int& arrivalTime, int& urgencyLevel);
+};
+
+#endif
@@ -0,0 +1,398 @@
+#include "BinaryTrace.h"
+#include "Varint.h"
+#include <climits>
+#include <cstring>
+
+static const char HEAD_MAGIC[8] = {'D', 'E', 'S', 'T', 'R', 'A', 'C', 'E'};
+static const char TAIL_MAGIC[8] = {'D', 'E', 'S', 'T', 'R', 'I', 'D', 'X'};
+static const unsigned char VERSION = 1;
+static const int MAX_EVENT_BYTES = 3 * MAX_VARINT;
+
+// grows a byte array so that n more bytes fit
+static void reserveBytes(unsigned char*& bytes, int used, int& capacity, int n)
+{
+    if (used + n <= capacity) {
+        return;
+    }
+    int newCapacity = (capacity == 0) ? 64 : capacity;
+    while (used + n > newCapacity) {
+        newCapacity *= 2;
+    }
+    unsigned char* bigger = new unsigned char[newCapacity];
+    if (used > 0) {
+        std::memcpy(bigger, bytes, used);
+    }
+    delete[] bytes;
+    bytes = bigger;
+    capacity = newCapacity;
+}
+
+BinaryTraceSink::BinaryTraceSink(std::ostream& os, int blockEvents)
+{
+    this->os = &os;
+    this->blockEvents = blockEvents > 0 ? blockEvents : 1;
+    block = new unsigned char[this->blockEvents * MAX_EVENT_BYTES];
+    blockUsed = 0;
+    current.events = 0;
+    previousTime = 0;
+    index = NULL;
+    numBlocks = 0;
+    indexCapacity = 0;
+    written = 0;
+    finished = false;
+    numDoctors = 0;
+    stacks = NULL;
+    stacksUsed = 0;
+    stacksCapacity = 0;
+    closed = false;
+
+    writeBytes((const unsigned char*)HEAD_MAGIC, 8);
+    writeBytes(&VERSION, 1);
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+    flush();
+    delete[] block;
+    delete[] index;
+    delete[] stacks;
+}
+
+void BinaryTraceSink::writeBytes(const unsigned char* bytes, int n)
+{
+    os->write((const char*)bytes, n);
+    written += n;
+}
+
+void BinaryTraceSink::closeBlock()
+{
+    if (current.events == 0) {
+        return;
+    }
+    if (numBlocks == indexCapacity) {
+        int newCapacity = (indexCapacity == 0) ? 16 : indexCapacity * 2;
+        BinaryTraceBlock* bigger = new BinaryTraceBlock[newCapacity];
+        for (int i = 0; i < numBlocks; i++) {
+            bigger[i] = index[i];
+        }
+        delete[] index;
+        index = bigger;
+        indexCapacity = newCapacity;
+    }
+    current.offset = written;
+    index[numBlocks] = current;
+    numBlocks++;
+    writeBytes(block, blockUsed);
+    blockUsed = 0;
+    current.events = 0;
+}
+
+void BinaryTraceSink::event(const Event& e)
+{
+    if (closed) {
+        return;
+    }
+    if (current.events == 0) {
+        previousTime = 0;
+        current.minTime = e.time;
+        current.maxTime = e.time;
+        current.minPatient = e.patientId;
+        current.maxPatient = e.patientId;
+    }
+    // DES times never go down, but the index does not count on it.
+    if (e.time < current.minTime) {
+        current.minTime = e.time;
+    }
+    if (e.time > current.maxTime) {
+        current.maxTime = e.time;
+    }
+    if (e.patientId < current.minPatient) {
+        current.minPatient = e.patientId;
+    }
+    if (e.patientId > current.maxPatient) {
+        current.maxPatient = e.patientId;
+    }
+    blockUsed += putSigned(block + blockUsed, (long long)e.time - previousTime);
+    previousTime = e.time;
+    blockUsed += putVarint(block + blockUsed, (zigzag(e.resourceId) << 3) | (unsigned long long)e.type);
+    blockUsed += putSigned(block + blockUsed, e.patientId);
+    current.events++;
+    if (current.events == blockEvents) {
+        closeBlock();
+    }
+}
+
+void BinaryTraceSink::simulationFinished()
+{
+    finished = true;
+}
+
+void BinaryTraceSink::doctorStack(int doctor, const MonotonicStack& stack)
+{
+    // doctors come in order 0, 1, ... from DES::run, so the index is implied.
+    (void)doctor;
+    int n = stack.length();
+    int* ids = new int[n > 0 ? n : 1];
+    stack.copyTo(ids);
+    reserveBytes(stacks, stacksUsed, stacksCapacity, (n + 1) * MAX_VARINT);
+    stacksUsed += putVarint(stacks + stacksUsed, (unsigned long long)n);
+    for (int i = 0; i < n; i++) {
+        stacksUsed += putSigned(stacks + stacksUsed, ids[i]);
+    }
+    delete[] ids;
+    numDoctors++;
+}
+
+void BinaryTraceSink::flush()
+{
+    if (closed) {
+        return;
+    }
+    closed = true;
+    closeBlock();
+
+    long long tailOffset = written;
+    unsigned char buffer[8 * MAX_VARINT];
+    buffer[0] = finished ? 1 : 0;
+    int n = 1;
+    n += putVarint(buffer + n, (unsigned long long)numDoctors);
+    writeBytes(buffer, n);
+    writeBytes(stacks, stacksUsed);
+
+    n = putVarint(buffer, (unsigned long long)numBlocks);
+    writeBytes(buffer, n);
+    for (int b = 0; b < numBlocks; b++) {
+        n = putVarint(buffer, (unsigned long long)index[b].offset);
+        n += putVarint(buffer + n, (unsigned long long)index[b].events);
+        n += putSigned(buffer + n, index[b].minTime);
+        n += putSigned(buffer + n, index[b].maxTime);
+        n += putSigned(buffer + n, index[b].minPatient);
+        n += putSigned(buffer + n, index[b].maxPatient);
+        writeBytes(buffer, n);
+    }
+    // fixed width, little endian, so the reader finds the tail from the end.
+    for (int i = 0; i < 8; i++) {
+        buffer[i] = (unsigned char)((unsigned long long)tailOffset >> (8 * i));
+    }
+    writeBytes(buffer, 8);
+    writeBytes((const unsigned char*)TAIL_MAGIC, 8);
+    os->flush();
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+{
+    this->is = &is;
+    index = NULL;
+    numBlocks = 0;
+    tailOffset = 0;
+    finished = false;
+    numDoctors = 0;
+    stacks = NULL;
+    stackLengths = NULL;
+    valid = false;
+    load();
+}
+
+BinaryTraceReader::~BinaryTraceReader()
+{
+    for (int d = 0; d < numDoctors; d++) {
+        delete[] stacks[d];
+    }
+    delete[] stacks;
+    delete[] stackLengths;
+    delete[] index;
+}
+
+void BinaryTraceReader::load()
+{
+    char head[9];
+    is->seekg(0, std::ios::beg);
+    if (!is->read(head, 9) || std::memcmp(head, HEAD_MAGIC, 8) != 0 || (unsigned char)head[8] != VERSION) {
+        return;
+    }
+    is->seekg(0, std::ios::end);
+    long long size = (long long)is->tellg();
+    if (size < 9 + 16) {
+        return;
+    }
+    unsigned char end[16];
+    is->seekg(size - 16, std::ios::beg);
+    if (!is->read((char*)end, 16) || std::memcmp(end + 8, TAIL_MAGIC, 8) != 0) {
+        return;
+    }
+    tailOffset = 0;
+    for (int i = 0; i < 8; i++) {
+        tailOffset |= (long long)end[i] << (8 * i);
+    }
+    // the tail size is kept in an int, a longer tail is not ours.
+    if (tailOffset < 9 || tailOffset > size - 16 || size - 16 - tailOffset > INT_MAX) {
+        return;
+    }
+
+    // the tail is small, read it in one go.
+    int tailSize = (int)(size - 16 - tailOffset);
+    unsigned char* tail = new unsigned char[tailSize > 0 ? tailSize : 1];
+    is->seekg(tailOffset, std::ios::beg);
+    is->read((char*)tail, tailSize);
+    const unsigned char* p = tail;
+    const unsigned char* stop = tail + tailSize;
+    unsigned long long v;
+
+    // Every count is checked against the bytes left before anything is
+    // allocated for it: a doctor, a stack id and a block take at least
+    // one, one and six bytes, an event at least three.
+    bool ok = tailSize > 0;
+    finished = ok && *p++ == 1;
+    p = getVarint(p, stop, v);
+    ok = ok && v <= (unsigned long long)(stop - p);
+    numDoctors = ok ? (int)v : 0;
+    stacks = new int*[numDoctors > 0 ? numDoctors : 1];
+    stackLengths = new int[numDoctors > 0 ? numDoctors : 1];
+    for (int d = 0; d < numDoctors; d++) {
+        p = getVarint(p, stop, v);
+        if (v > (unsigned long long)(stop - p)) {
+            ok = false;
+            numDoctors = d; // the ones the destructor has to free
+            break;
+        }
+        stackLengths[d] = (int)v;
+        stacks[d] = new int[stackLengths[d] > 0 ? stackLengths[d] : 1];
+        for (int i = 0; i < stackLengths[d]; i++) {
+            p = getSigned(p, stop, stacks[d][i]);
+        }
+    }
+    p = getVarint(p, stop, v);
+    ok = ok && v <= (unsigned long long)(stop - p) / 6;
+    numBlocks = ok ? (int)v : 0;
+    index = new BinaryTraceBlock[numBlocks > 0 ? numBlocks : 1];
+    long long previous = 8; // blocks start after the 9 byte header
+    for (int b = 0; b < numBlocks && ok; b++) {
+        p = getVarint(p, stop, v);
+        ok = v > (unsigned long long)previous && v < (unsigned long long)tailOffset;
+        index[b].offset = (long long)v;
+        previous = index[b].offset;
+        p = getVarint(p, stop, v);
+        ok = ok && v <= (unsigned long long)INT_MAX;
+        index[b].events = (int)v;
+        p = getSigned(p, stop, index[b].minTime);
+        p = getSigned(p, stop, index[b].maxTime);
+        p = getSigned(p, stop, index[b].minPatient);
+        p = getSigned(p, stop, index[b].maxPatient);
+    }
+    for (int b = 0; b < numBlocks && ok; b++) {
+        long long end = (b + 1 < numBlocks) ? index[b + 1].offset : tailOffset;
+        ok = (long long)index[b].events <= (end - index[b].offset) / 3;
+    }
+    delete[] tail;
+    valid = ok && p == stop;
+    is->clear();
+}
+
+bool BinaryTraceReader::isValid() const
+{
+    return valid;
+}
+
+int BinaryTraceReader::blockCount() const
+{
+    return numBlocks;
+}
+
+const BinaryTraceBlock& BinaryTraceReader::block(int b) const
+{
+    return index[b];
+}
+
+long long BinaryTraceReader::eventCount() const
+{
+    long long total = 0;
+    for (int b = 0; b < numBlocks; b++) {
+        total += index[b].events;
+    }
+    return total;
+}
+
+int BinaryTraceReader::readBlock(int b, Event* out)
+{
+    if (!valid || b < 0 || b >= numBlocks) {
+        return 0;
+    }
+    long long end = (b + 1 < numBlocks) ? index[b + 1].offset : tailOffset;
+    int size = (int)(end - index[b].offset);
+    unsigned char* bytes = new unsigned char[size > 0 ? size : 1];
+    is->seekg(index[b].offset, std::ios::beg);
+    is->read((char*)bytes, size);
+    is->clear();
+
+    const unsigned char* p = bytes;
+    const unsigned char* stop = bytes + size;
+    long long time = 0;
+    int n = 0;
+    for (; n < index[b].events && p < stop; n++) {
+        unsigned long long delta, packed;
+        p = getVarint(p, stop, delta);
+        p = getVarint(p, stop, packed);
+        p = getSigned(p, stop, out[n].patientId);
+        time += unzigzag(delta);
+        out[n].time = (int)time;
+        out[n].type = (EventType)(packed & 7);
+        out[n].resourceId = (int)unzigzag(packed >> 3);
+    }
+    delete[] bytes;
+    return n;
+}
+
+int BinaryTraceReader::query(int fromTime, int toTime, int patientId, TraceSink& sink)
+{
+    if (!valid) {
+        return 0;
+    }
+    int decoded = 0;
+    Event* events = NULL;
+    int capacity = 0;
+    for (int b = 0; b < numBlocks; b++) {
+        const BinaryTraceBlock& info = index[b];
+        if (info.maxTime < fromTime || info.minTime > toTime) {
+            continue;
+        }
+        if (patientId != -1 && (patientId < info.minPatient || patientId > info.maxPatient)) {
+            continue;
+        }
+        if (info.events > capacity) {
+            delete[] events;
+            capacity = info.events;
+            events = new Event[capacity];
+        }
+        int n = readBlock(b, events);
+        decoded++;
+        for (int i = 0; i < n; i++) {
+            if (events[i].time >= fromTime && events[i].time <= toTime
+                && (patientId == -1 || events[i].patientId == patientId)) {
+                sink.event(events[i]);
+            }
+        }
+    }
+    delete[] events;
+    return decoded;
+}
+
+void BinaryTraceReader::replay(TraceSink& sink)
+{
+    if (!valid) {
+        return;
+    }
+    query(INT_MIN, INT_MAX, -1, sink);
+    if (finished) {
+        sink.simulationFinished();
+    }
+    for (int d = 0; d < numDoctors; d++) {
+        // ids grow from the bottom up, pushing them back in that order
+        // keeps every one of them.
+        MonotonicStack stack;
+        for (int i = stackLengths[d] - 1; i >= 0; i--) {
+            stack.push(stacks[d][i]);
+        }
+        sink.doctorStack(d, stack);
+    }
+    sink.flush();
+}
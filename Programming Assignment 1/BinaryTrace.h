@@ -0,0 +1,96 @@
+#ifndef BINARYTRACE_H
+#define BINARYTRACE_H
+
+#include "TraceSink.h"
+#include <iostream>
+
+// Binary form of the DES trace, a few bytes per event instead of ~60.
+//
+// file:   "DESTRACE" 1, blocks, tail, tail offset (8 bytes), "DESTRIDX"
+// block:  up to blockEvents events, each as three varints:
+//         zigzag(time - previous time), zigzag(resource) << 3 | type,
+//         zigzag(patient). The first event of a block is relative to 0,
+//         so every block decodes on its own.
+// tail:   finished flag, the doctor stacks (count, ids from the top), and
+//         the block index: offset, events, smallest and largest time and
+//         smallest and largest patient of every block.
+//
+// The index lets a reader skip every block outside a time range or
+// without a given patient.
+struct BinaryTraceBlock
+{
+    long long offset;
+    int events;
+    int minTime, maxTime;
+    int minPatient, maxPatient;
+};
+
+class BinaryTraceSink : public TraceSink {
+private:
+    std::ostream* os;
+    int blockEvents;
+    unsigned char* block; // encoded events of the open block
+    int blockUsed;
+    BinaryTraceBlock current;
+    int previousTime;
+    BinaryTraceBlock* index;
+    int numBlocks;
+    int indexCapacity;
+    long long written; // bytes written to os
+    bool finished;
+    int numDoctors;
+    unsigned char* stacks; // encoded doctor stacks
+    int stacksUsed;
+    int stacksCapacity;
+    bool closed;
+
+    void closeBlock();
+    void writeBytes(const unsigned char* bytes, int n);
+
+    BinaryTraceSink(const BinaryTraceSink& other); // not copyable
+    BinaryTraceSink& operator=(const BinaryTraceSink& other);
+
+public:
+    BinaryTraceSink(std::ostream& os, int blockEvents = 4096);
+    ~BinaryTraceSink();
+    void event(const Event& e);
+    void simulationFinished();
+    void doctorStack(int doctor, const MonotonicStack& stack);
+    void flush(); // writes the tail, nothing can be added afterwards
+};
+
+// Reads a binary trace from a seekable stream.
+class BinaryTraceReader {
+private:
+    std::istream* is;
+    BinaryTraceBlock* index;
+    int numBlocks;
+    long long tailOffset;
+    bool finished;
+    int numDoctors;
+    int** stacks; // ids from the top
+    int* stackLengths;
+    bool valid;
+
+    void load();
+
+    BinaryTraceReader(const BinaryTraceReader& other); // not copyable
+    BinaryTraceReader& operator=(const BinaryTraceReader& other);
+
+public:
+    BinaryTraceReader(std::istream& is);
+    ~BinaryTraceReader();
+    bool isValid() const; // false if the stream is not a complete trace
+    int blockCount() const;
+    const BinaryTraceBlock& block(int b) const;
+    long long eventCount() const;
+    int readBlock(int b, Event* out); // decodes block b, returns its events (fewer if its bytes run out)
+
+    // Events with time in [fromTime, toTime], of patientId unless it is -1,
+    // go to the sink. Returns how many blocks had to be decoded.
+    int query(int fromTime, int toTime, int patientId, TraceSink& sink);
+    // The whole trace to the sink, the text form when it is an OStreamTraceSink.
+    void replay(TraceSink& sink);
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "BufferedTraceSink.h"
+#include <cstring>
+#include <sstream>
+
+// longest event line: 4 ints of 11 characters and the fixed text
+static const int MAX_EVENT_LINE = 96;
+
+// writes v in decimal at p, returns the end
+static char* formatInt(char* p, int v)
+{
+    unsigned int u = (unsigned int)v;
+    if (v < 0) {
+        *p++ = '-';
+        u = 0u - u;
+    }
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+static char* copyText(char* p, const char* text, int n)
+{
+    std::memcpy(p, text, n);
+    return p + n;
+}
+
+BufferedTraceSink::BufferedTraceSink(std::ostream& os, int bufferSize)
+{
+    this->os = &os;
+    this->bufferSize = bufferSize < MAX_EVENT_LINE ? MAX_EVENT_LINE : bufferSize;
+    buffers[0] = new char[this->bufferSize];
+    buffers[1] = new char[this->bufferSize];
+    active = 0;
+    used = 0;
+    pending = -1;
+    pendingSize = 0;
+    stopping = false;
+    writer = std::thread(&BufferedTraceSink::writeLoop, this);
+}
+
+BufferedTraceSink::~BufferedTraceSink()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+    delete[] buffers[0];
+    delete[] buffers[1];
+}
+
+void BufferedTraceSink::writeLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        while (pending == -1 && !stopping) {
+            changed.wait(guard);
+        }
+        if (pending == -1) {
+            return;
+        }
+        // the buffer is ours until pending is reset, write without the lock.
+        int index = pending;
+        int size = pendingSize;
+        guard.unlock();
+        os->write(buffers[index], size);
+        guard.lock();
+        pending = -1;
+        changed.notify_all();
+    }
+}
+
+void BufferedTraceSink::handOff()
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (pending != -1) {
+            changed.wait(guard);
+        }
+        pending = active;
+        pendingSize = used;
+    }
+    changed.notify_all();
+    active = 1 - active;
+    used = 0;
+}
+
+void BufferedTraceSink::append(const char* text, int n)
+{
+    while (n > 0) {
+        if (used == bufferSize) {
+            handOff();
+        }
+        int part = bufferSize - used;
+        if (part > n) {
+            part = n;
+        }
+        std::memcpy(buffers[active] + used, text, part);
+        used += part;
+        text += part;
+        n -= part;
+    }
+}
+
+void BufferedTraceSink::event(const Event& e)
+{
+    if (used + MAX_EVENT_LINE > bufferSize) {
+        handOff();
+    }
+    char* start = buffers[active] + used;
+    char* p = start;
+    p = copyText(p, "[TIME ", 6);
+    p = formatInt(p, e.time);
+    p = copyText(p, "] Event Type: ", 14);
+    p = formatInt(p, (int)e.type);
+    p = copyText(p, ", Patient Id: ", 14);
+    p = formatInt(p, e.patientId);
+    p = copyText(p, ", Resource Id: ", 15);
+    p = formatInt(p, e.resourceId);
+    *p++ = '\n';
+    used += (int)(p - start);
+}
+
+void BufferedTraceSink::simulationFinished()
+{
+    append("Simulation finished.\n", 21);
+}
+
+void BufferedTraceSink::doctorStack(int doctor, const MonotonicStack& stack)
+{
+    // once per doctor at the end, the stream operator is fine here.
+    std::ostringstream line;
+    line << "Monotonic Stack of Doctor " << doctor << " is " << stack << '\n';
+    std::string text = line.str();
+    append(text.data(), (int)text.size());
+}
+
+void BufferedTraceSink::flush()
+{
+    if (used > 0) {
+        handOff();
+    }
+    std::unique_lock<std::mutex> guard(lock);
+    while (pending != -1) {
+        changed.wait(guard);
+    }
+    os->flush();
+}
@@ -0,0 +1,46 @@
+#ifndef BUFFEREDTRACESINK_H
+#define BUFFEREDTRACESINK_H
+
+#include "TraceSink.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Text trace, byte for byte the same as OStreamTraceSink, for long runs.
+// Lines are formatted by hand into one of two preallocated buffers. A full
+// buffer goes to a writer thread that writes it to the stream while the
+// simulation fills the other one; the simulation only waits if the writer
+// is still busy with the previous buffer. Nothing else may write to the
+// stream until flush() or the destructor returns.
+class BufferedTraceSink : public TraceSink {
+private:
+    std::ostream* os;
+    char* buffers[2];
+    int bufferSize;
+    int active; // buffer the simulation is filling
+    int used;
+
+    std::thread writer;
+    std::mutex lock;
+    std::condition_variable changed;
+    int pending; // buffer the writer has to write, -1 if none
+    int pendingSize;
+    bool stopping;
+
+    void handOff();
+    void append(const char* text, int n);
+    void writeLoop();
+
+    BufferedTraceSink(const BufferedTraceSink& other); // not copyable
+    BufferedTraceSink& operator=(const BufferedTraceSink& other);
+
+public:
+    BufferedTraceSink(std::ostream& os, int bufferSize = 1 << 20);
+    ~BufferedTraceSink();
+    void event(const Event& e);
+    void simulationFinished();
+    void doctorStack(int doctor, const MonotonicStack& stack);
+    void flush(); // waits until everything is written
+};
+
+#endif
@@ -0,0 +1,320 @@
+#include "CalendarQueue.h"
+
+// how many of the earliest events are looked at when picking a new width
+static const int WIDTH_SAMPLES = 25;
+
+CalendarQueue::CalendarQueue()
+{
+    nodes = NULL;
+    nodeCapacity = 0;
+    freeNode = -1;
+
+    numBuckets = 2;
+    width = 1;
+    buckets = new int[numBuckets];
+    bucketTails = new int[numBuckets];
+    for (int i = 0; i < numBuckets; i++) {
+        buckets[i] = -1;
+        bucketTails[i] = -1;
+    }
+    count = 0;
+
+    lastBucket = 0;
+    bucketTop = width;
+    resizeEnabled = true;
+}
+
+CalendarQueue::~CalendarQueue()
+{
+    delete[] nodes;
+    delete[] buckets;
+    delete[] bucketTails;
+}
+
+int CalendarQueue::bucketOf(int time) const
+{
+    // floor division so negative times land in the right day too.
+    long long day = time / width;
+    if (time % width != 0 && time < 0) {
+        day--;
+    }
+    return (int)(day & (numBuckets - 1));
+}
+
+long long CalendarQueue::windowEnd(int time) const
+{
+    long long day = time / width;
+    if (time % width != 0 && time < 0) {
+        day--;
+    }
+    return (day + 1) * width;
+}
+
+int CalendarQueue::allocNode(const Event& data)
+{
+    if (freeNode == -1) {
+        int newCapacity = (nodeCapacity == 0) ? 16 : nodeCapacity * 2;
+        CalendarNode* bigger = new CalendarNode[newCapacity];
+        for (int i = 0; i < nodeCapacity; i++) {
+            bigger[i] = nodes[i];
+        }
+        // chain the new nodes into the free list.
+        for (int i = nodeCapacity; i < newCapacity; i++) {
+            bigger[i].next = (i + 1 < newCapacity) ? i + 1 : -1;
+        }
+        delete[] nodes;
+        nodes = bigger;
+        freeNode = nodeCapacity;
+        nodeCapacity = newCapacity;
+    }
+    int node = freeNode;
+    freeNode = nodes[node].next;
+    nodes[node].data = data;
+    nodes[node].next = -1;
+    return node;
+}
+
+void CalendarQueue::insertNode(int node)
+{
+    const Event& data = nodes[node].data;
+    int b = bucketOf(data.time);
+    nodes[node].next = -1;
+
+    // events mostly come in increasing order, so try the tail first.
+    int tail = bucketTails[b];
+    if (tail == -1) {
+        buckets[b] = node;
+        bucketTails[b] = node;
+        return;
+    }
+    if (!(data < nodes[tail].data)) {
+        nodes[tail].next = node;
+        bucketTails[b] = node;
+        return;
+    }
+    int head = buckets[b];
+    if (data < nodes[head].data) {
+        nodes[node].next = head;
+        buckets[b] = node;
+        return;
+    }
+    // same tie rule as SortedLinkedList, equal events go after the old ones.
+    int curr = head;
+    while (!(data < nodes[nodes[curr].next].data)) {
+        curr = nodes[curr].next;
+    }
+    nodes[node].next = nodes[curr].next;
+    nodes[curr].next = node;
+}
+
+int CalendarQueue::findSmallestBucket(long long& top) const
+{
+    // walk one year of days starting from where the last dequeue left off.
+    int i = lastBucket;
+    long long t = bucketTop;
+    for (int n = 0; n < numBuckets; n++) {
+        int head = buckets[i];
+        if (head != -1 && nodes[head].data.time < t) {
+            top = t;
+            return i;
+        }
+        i = (i + 1) & (numBuckets - 1);
+        t += width;
+    }
+
+    // nothing due this year, the queue is sparse, so look at every bucket.
+    int best = -1;
+    for (int b = 0; b < numBuckets; b++) {
+        int head = buckets[b];
+        if (head != -1 && (best == -1 || nodes[head].data < nodes[buckets[best]].data)) {
+            best = b;
+        }
+    }
+    top = windowEnd(nodes[buckets[best]].data.time);
+    return best;
+}
+
+int CalendarQueue::estimateWidth()
+{
+    // Brown's heuristic: three times the average gap between the first few
+    // events, ignoring gaps that are far above the average.
+    int samples = count < WIDTH_SAMPLES ? count : WIDTH_SAMPLES;
+    if (samples < 2) {
+        return width;
+    }
+    Event sampled[WIDTH_SAMPLES];
+    for (int i = 0; i < samples; i++) {
+        sampled[i] = removeSmallest();
+    }
+
+    long long total = 0;
+    for (int i = 1; i < samples; i++) {
+        total += (long long)sampled[i].time - sampled[i - 1].time;
+    }
+    long long average = total / (samples - 1);
+    long long kept = 0;
+    int keptCount = 0;
+    for (int i = 1; i < samples; i++) {
+        long long gap = (long long)sampled[i].time - sampled[i - 1].time;
+        if (gap <= 2 * average) {
+            kept += gap;
+            keptCount++;
+        }
+    }
+
+    for (int i = 0; i < samples; i++) {
+        add(sampled[i]);
+    }
+
+    long long newWidth = (keptCount > 0) ? 3 * kept / keptCount : 1;
+    if (newWidth < 1) {
+        newWidth = 1;
+    }
+    // keeps width * numBuckets far away from overflowing.
+    if (newWidth > (1 << 24)) {
+        newWidth = 1 << 24;
+    }
+    return (int)newWidth;
+}
+
+void CalendarQueue::resize(int newNumBuckets)
+{
+    resizeEnabled = false;
+    int newWidth = estimateWidth();
+
+    // unlink every node into one chain, then rehash with the new layout.
+    int chain = -1;
+    int smallest = -1;
+    for (int b = 0; b < numBuckets; b++) {
+        int curr = buckets[b];
+        while (curr != -1) {
+            int next = nodes[curr].next;
+            if (smallest == -1 || nodes[curr].data < nodes[smallest].data) {
+                smallest = curr;
+            }
+            nodes[curr].next = chain;
+            chain = curr;
+            curr = next;
+        }
+    }
+
+    delete[] buckets;
+    delete[] bucketTails;
+    numBuckets = newNumBuckets;
+    width = newWidth;
+    buckets = new int[numBuckets];
+    bucketTails = new int[numBuckets];
+    for (int i = 0; i < numBuckets; i++) {
+        buckets[i] = -1;
+        bucketTails[i] = -1;
+    }
+
+    // the chain is in reverse bucket order, reinsert it reversed back so
+    // the tail fast path in insertNode hits for most nodes.
+    int reversed = -1;
+    while (chain != -1) {
+        int next = nodes[chain].next;
+        nodes[chain].next = reversed;
+        reversed = chain;
+        chain = next;
+    }
+    while (reversed != -1) {
+        int next = nodes[reversed].next;
+        insertNode(reversed);
+        reversed = next;
+    }
+
+    if (smallest != -1) {
+        lastBucket = bucketOf(nodes[smallest].data.time);
+        bucketTop = windowEnd(nodes[smallest].data.time);
+    }
+    resizeEnabled = true;
+}
+
+void CalendarQueue::add(const Event& data)
+{
+    // an event before the window we dequeue from moves the window back.
+    if (count == 0 || data.time < bucketTop - width) {
+        lastBucket = bucketOf(data.time);
+        bucketTop = windowEnd(data.time);
+    }
+    insertNode(allocNode(data));
+    count++;
+
+    if (resizeEnabled && count > 2 * numBuckets) {
+        resize(numBuckets * 2);
+    }
+}
+
+Event CalendarQueue::removeSmallest()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    long long top;
+    int b = findSmallestBucket(top);
+    int node = buckets[b];
+    Event data = nodes[node].data;
+
+    buckets[b] = nodes[node].next;
+    if (buckets[b] == -1) {
+        bucketTails[b] = -1;
+    }
+    nodes[node].next = freeNode;
+    freeNode = node;
+    count--;
+
+    lastBucket = b;
+    bucketTop = top;
+
+    if (resizeEnabled && numBuckets > 2 && count < numBuckets / 2) {
+        resize(numBuckets / 2);
+    }
+    return data;
+}
+
+bool CalendarQueue::isEmpty() const
+{
+    return count == 0;
+}
+
+int CalendarQueue::length() const
+{
+    return count;
+}
+
+Event CalendarQueue::getFirst() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    long long top;
+    return nodes[buckets[findSmallestBucket(top)]].data;
+}
+
+Event CalendarQueue::getLast() const
+{
+    // the largest event of each bucket is its tail.
+    if (isEmpty()) {
+        return Event();
+    }
+    int largest = -1;
+    for (int b = 0; b < numBuckets; b++) {
+        int tail = bucketTails[b];
+        if (tail != -1 && (largest == -1 || nodes[largest].data < nodes[tail].data)) {
+            largest = tail;
+        }
+    }
+    return nodes[largest].data;
+}
+
+void CalendarQueue::copyTo(Event* out) const
+{
+    int i = 0;
+    for (int b = 0; b < numBuckets; b++) {
+        for (int n = buckets[b]; n != -1; n = nodes[n].next) {
+            out[i] = nodes[n].data;
+            i++;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef CALENDARQUEUE_H
+#define CALENDARQUEUE_H
+
+#include "EventSet.h"
+
+// Calendar queue (R. Brown, 1988). Events are hashed into buckets by
+// time / width, like days of a year. Each bucket is a short list sorted by
+// Event::operator<. The number of buckets follows the number of events and
+// the width is re-estimated from the event spacing on every resize, so
+// enqueue and dequeue are O(1) amortized when event times cluster ahead of
+// the current time, which is what DES produces.
+class CalendarQueue : public EventSet {
+private:
+    struct CalendarNode {
+        Event data;
+        int next; // index of next node in the same bucket, -1 at the end
+    };
+
+    CalendarNode* nodes; // node storage, unused nodes are chained by next
+    int nodeCapacity;
+    int freeNode;
+
+    int* buckets; // head node of each bucket, -1 if bucket is empty
+    int* bucketTails; // last node of each bucket, -1 if bucket is empty
+    int numBuckets; // always a power of two
+    int width; // time span of one bucket
+    int count;
+
+    int lastBucket; // bucket the last dequeue was served from
+    long long bucketTop; // end (exclusive) of lastBucket's window in the current year
+    bool resizeEnabled;
+
+    int bucketOf(int time) const;
+    long long windowEnd(int time) const;
+    int allocNode(const Event& data);
+    void insertNode(int node);
+    int findSmallestBucket(long long& top) const;
+    int estimateWidth();
+    void resize(int newNumBuckets);
+
+    CalendarQueue(const CalendarQueue& other); // not copyable
+    CalendarQueue& operator=(const CalendarQueue& other);
+
+public:
+    CalendarQueue();
+    ~CalendarQueue();
+    void add(const Event& data);
+    Event removeSmallest();
+    bool isEmpty() const;
+    int length() const;
+    Event getFirst() const;
+    Event getLast() const;
+    void copyTo(Event* out) const;
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "Checkpoint.h"
+#include "Varint.h"
+#include <climits>
+#include <cstring>
+
+CheckpointWriter::CheckpointWriter()
+{
+    bytes = NULL;
+    used = 0;
+    capacity = 0;
+    bad = false;
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    delete[] bytes;
+}
+
+// the next capacity for a buffer of an int size, at most INT_MAX
+static int grownCapacity(int capacity, int initial)
+{
+    long long bigger = (capacity == 0) ? initial : 2ll * capacity;
+    return bigger < INT_MAX ? (int)bigger : INT_MAX;
+}
+
+bool CheckpointWriter::reserve(int n)
+{
+    if (bad || used > INT_MAX - n) {
+        bad = true;
+        return false;
+    }
+    if (used + n <= capacity) {
+        return true;
+    }
+    int newCapacity = grownCapacity(capacity, 256);
+    while (used + n > newCapacity) {
+        newCapacity = grownCapacity(newCapacity, 256);
+    }
+    unsigned char* bigger = new unsigned char[newCapacity];
+    if (used > 0) {
+        std::memcpy(bigger, bytes, used);
+    }
+    delete[] bytes;
+    bytes = bigger;
+    capacity = newCapacity;
+    return true;
+}
+
+void CheckpointWriter::putMagic(const char* magic)
+{
+    if (!reserve(8)) {
+        return;
+    }
+    std::memcpy(bytes + used, magic, 8);
+    used += 8;
+}
+
+void CheckpointWriter::putInt(long long v)
+{
+    if (!reserve(MAX_VARINT)) {
+        return;
+    }
+    used += putSigned(bytes + used, v);
+}
+
+void CheckpointWriter::putCount(long long n)
+{
+    if (!reserve(MAX_VARINT)) {
+        return;
+    }
+    used += putVarint(bytes + used, (unsigned long long)n);
+}
+
+void CheckpointWriter::putBool(bool b)
+{
+    putCount(b ? 1 : 0);
+}
+
+void CheckpointWriter::putDouble(double d)
+{
+    unsigned long long bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    putCount((long long)bits);
+}
+
+int CheckpointWriter::size() const
+{
+    return used;
+}
+
+bool CheckpointWriter::failed() const
+{
+    return bad;
+}
+
+bool CheckpointWriter::writeTo(std::ostream& os) const
+{
+    if (bad) {
+        return false;
+    }
+    if (used > 0) {
+        os.write((const char*)bytes, used);
+    }
+    return (bool)os;
+}
+
+CheckpointReader::CheckpointReader(std::istream& in)
+{
+    bytes = NULL;
+    size = 0;
+    position = 0;
+    bad = false;
+    int capacity = 0;
+    while (in) {
+        if (size == capacity) {
+            if (capacity == INT_MAX) {
+                // more than fits in an int, getLength could not bound it.
+                bad = true;
+                break;
+            }
+            int newCapacity = grownCapacity(capacity, 4096);
+            unsigned char* bigger = new unsigned char[newCapacity];
+            if (size > 0) {
+                std::memcpy(bigger, bytes, size);
+            }
+            delete[] bytes;
+            bytes = bigger;
+            capacity = newCapacity;
+        }
+        in.read((char*)bytes + size, capacity - size);
+        size += (int)in.gcount();
+    }
+}
+
+CheckpointReader::~CheckpointReader()
+{
+    delete[] bytes;
+}
+
+bool CheckpointReader::getMagic(const char* magic)
+{
+    if (bad || size - position < 8 || std::memcmp(bytes + position, magic, 8) != 0) {
+        bad = true;
+        return false;
+    }
+    position += 8;
+    return true;
+}
+
+unsigned long long CheckpointReader::getRaw()
+{
+    if (bad) {
+        return 0;
+    }
+    const unsigned char* p = bytes + position;
+    const unsigned char* end = bytes + size;
+    // the last byte of a varint has the high bit clear.
+    int length = 0;
+    while (p + length < end && length < MAX_VARINT && (p[length] & 0x80) != 0) {
+        length++;
+    }
+    if (p + length == end || length == MAX_VARINT) {
+        bad = true;
+        return 0;
+    }
+    unsigned long long v;
+    position = (int)(getVarint(p, end, v) - bytes);
+    return v;
+}
+
+long long CheckpointReader::getInt()
+{
+    return unzigzag(getRaw());
+}
+
+int CheckpointReader::getInt32()
+{
+    long long v = getInt();
+    if (v < INT_MIN || v > INT_MAX) {
+        bad = true;
+        return 0;
+    }
+    return (int)v;
+}
+
+int CheckpointReader::getCount(int limit)
+{
+    unsigned long long v = getRaw();
+    if (v > (unsigned long long)(limit > 0 ? limit : 0)) {
+        bad = true;
+        return 0;
+    }
+    return (int)v;
+}
+
+int CheckpointReader::getLength()
+{
+    // every element takes at least a byte, so a longer count is corrupt.
+    return getCount(size - position);
+}
+
+bool CheckpointReader::getBool()
+{
+    return getCount(1) == 1;
+}
+
+double CheckpointReader::getDouble()
+{
+    unsigned long long bits = getRaw();
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return bad ? 0.0 : d;
+}
+
+void CheckpointReader::fail()
+{
+    bad = true;
+}
+
+bool CheckpointReader::failed() const
+{
+    return bad;
+}
+
+bool CheckpointReader::atEnd() const
+{
+    return position == size;
+}
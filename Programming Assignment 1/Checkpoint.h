@@ -0,0 +1,67 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <iostream>
+
+// Byte buffers for DES checkpoints. Every value is a varint (see Varint.h),
+// so the format has no alignment or byte order concerns. Sizes are ints: a
+// checkpoint that would pass INT_MAX bytes fails instead of wrapping.
+
+class CheckpointWriter {
+private:
+    unsigned char* bytes;
+    int used;
+    int capacity;
+    bool bad;
+
+    bool reserve(int n); // false, and failed(), past INT_MAX bytes
+
+    CheckpointWriter(const CheckpointWriter& other); // not copyable
+    CheckpointWriter& operator=(const CheckpointWriter& other);
+
+public:
+    CheckpointWriter();
+    ~CheckpointWriter();
+    void putMagic(const char* magic); // 8 bytes
+    void putInt(long long v);
+    void putCount(long long n); // non negative
+    void putBool(bool b);
+    void putDouble(double d);
+    int size() const;
+    bool failed() const; // a put did not fit, the checkpoint is incomplete
+    bool writeTo(std::ostream& os) const; // false if failed() or the stream failed
+};
+
+// Reads the whole stream up front. A read past the end or a malformed
+// value sets failed() and returns 0 from then on, so a loader can read
+// everything and check once at the end.
+class CheckpointReader {
+private:
+    unsigned char* bytes;
+    int size;
+    int position;
+    bool bad;
+
+    unsigned long long getRaw();
+
+    CheckpointReader(const CheckpointReader& other); // not copyable
+    CheckpointReader& operator=(const CheckpointReader& other);
+
+public:
+    CheckpointReader(std::istream& in); // failed() if longer than INT_MAX bytes
+    ~CheckpointReader();
+    bool getMagic(const char* magic); // false, and failed(), on a mismatch
+    long long getInt();
+    int getInt32(); // failed() if the value does not fit in an int
+    int getCount(int limit); // 0 to limit, failed() otherwise
+    // number of elements that follow, each of at least one byte, so it
+    // is safe to size an array with
+    int getLength();
+    bool getBool();
+    double getDouble();
+    void fail();
+    bool failed() const;
+    bool atEnd() const;
+};
+
+#endif
@@ -1,92 +1,705 @@
 #include "DES.h"
 #include "Event.h"
 #include <iostream>
+#include <sstream>
 #include <cstdlib>
+#include <algorithm>
+
+static const char* CHECKPOINT_MAGIC = "DESCKPT1";
 
 DES::DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
-int numPatients, int* urgencyLevels, int* patientArrivalTimes) : doctorQueue(numTiers)
+ArrivalSource* arrivals, EventSetEngine engine) : doctorQueue(numTiers), eventQueue(engine),
+triagePool(numTriages), doctorPool(numDoctors), collector(numTriages, numDoctors, numTiers),
+streamSink(std::cout)
 {
-    // YOUR CODE GOES HERE
     this->numTriages = numTriages;
     this->numDoctors = numDoctors;
     this->numTiers = numTiers;
     this->triageDuration = tDuration;
     this->doctorVisitDuration = dDuration;
     this->boringDuration = bDuration;
-    
+    this->arrivals = arrivals;
+    this->lastArrival = 0;
+    this->engine = engine;
+    this->now = 0;
+    this->cancelBoredomTimers = false;
+    this->useTimingWheel = true;
+    this->trace = &streamSink;
+    this->summaryOnly = false;
+#ifdef DES_PROFILE
+    this->profileStream = &std::cerr;
+#endif
+    stats.eventsProcessed = 0;
+    stats.patientsTreated = 0;
+    stats.patientsBored = 0;
+    stats.finishTime = -1;
+    stats.peakPatients = 0;
+    stats.boredInTriage = 0;
+    stats.boredAtDoctor = 0;
+    stats.maxTriageQueue = 0;
+    stats.maxDoctorQueue = 0;
+    stats.triageUtilization = 0;
+    stats.doctorUtilization = 0;
+    stats.patientsTransferred = 0;
+    stats.patientsReceived = 0;
+    hospitalId = 0;
+    transferThreshold = -1;
+    transferDestination = -1;
+    transferDelay = 0;
 
-    triageAvailable = new bool[numTriages];
-    doctorAvailable = new bool[numDoctors];
     doctorStacks = new MonotonicStack[numDoctors];
+}
 
-    for (int i = 0; i < numTriages; i++) {
-        triageAvailable[i] = true;
-    }
-
-    for (int i = 0; i < numDoctors; i++) {
-        doctorAvailable[i] = true;
-    }
-
-    this->urgencyLevels = new int[numPatients];
+DES::DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
+int numPatients, const int* urgencyLevels, const int* patientArrivalTimes, EventSetEngine engine)
+: DES(numTriages, numDoctors, numTiers, tDuration, dDuration, bDuration, (ArrivalSource*)NULL, engine)
+{
+    // YOUR CODE GOES HERE
+    // the times may come in any order here, so everybody is enqueued now.
+    patients.reserve(numPatients);
     for (int i = 0; i < numPatients; i++) {
-        this->urgencyLevels[i] = urgencyLevels[i];
+        patients.add(urgencyLevels[i]);
 
         Event e(patientArrivalTimes[i], TriageQueueEntrance, i, -1);
         // e is given in processEvent, so use it.
         eventQueue.enqueue(e);
     }
-    
+    stats.peakPatients = patients.size();
+}
+
+DES::DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
+ArrivalSource& arrivals, EventSetEngine engine)
+: DES(numTriages, numDoctors, numTiers, tDuration, dDuration, bDuration, &arrivals, engine)
+{
+    admitNext();
 }
 
 DES::~DES()
 {
     // YOUR CODE GOES HERE
-    delete[] triageAvailable;
-    delete[] doctorAvailable;
     delete[] doctorStacks;
-    delete[] urgencyLevels;
 }
 
-void DES::run()
+void DES::setCancelBoredomTimers(bool cancel)
 {
-    // YOUR CODE GOES HERE
-    while(!(eventQueue.isEmpty())){
-        Event e = eventQueue.dequeue();
+    cancelBoredomTimers = cancel;
+}
+
+void DES::setTimingWheel(bool use)
+{
+    useTimingWheel = use;
+}
+
+void DES::setOutputStream(std::ostream& os)
+{
+    streamSink.setStream(os);
+    trace = &streamSink;
+}
+
+void DES::setTraceSink(TraceSink& sink)
+{
+    trace = &sink;
+}
+
+void DES::setSummaryOnly(bool summaryOnly)
+{
+    this->summaryOnly = summaryOnly;
+}
+
+const DESStatistics& DES::getStatistics() const
+{
+    return stats;
+}
+
+const StatisticsCollector& DES::getCollector() const
+{
+    return collector;
+}
+
+#ifdef DES_PROFILE
+void DES::setProfileStream(std::ostream& os)
+{
+    profileStream = &os;
+}
+
+const DESProfiler& DES::getProfiler() const
+{
+    return profiler;
+}
+#endif
+
+double DES::getMeanWait(int tier) const
+{
+    if (tier < 0 || tier >= numTiers) {
+        return -1;
+    }
+    return collector.getDoctorWait(tier).mean();
+}
+
+int DES::scheduleTimer(const Event& timer)
+{
+    if (useTimingWheel) {
+        DES_PROFILE_COUNT(profiler.timerSchedules);
+        DES_PROFILE_TIME(profiler.timerTicks);
+        return boredomTimers.schedule(timer);
+    }
+    return eventQueue.enqueue(timer);
+}
+
+void DES::cancelTimer(int& timer)
+{
+    if (cancelBoredomTimers && timer != -1) {
+        if (useTimingWheel) {
+            DES_PROFILE_COUNT(profiler.timerCancels);
+            DES_PROFILE_TIME(profiler.timerTicks);
+            boredomTimers.cancel(timer);
+        }
+        else {
+            eventQueue.cancel(timer);
+        }
+    }
+    timer = -1;
+}
+
+// reads the next patient from the arrival source and schedules the arrival
+void DES::admitNext()
+{
+    int time, urgency;
+    if (arrivals == NULL || !arrivals->next(time, urgency)) {
+        return;
+    }
+    if (time < lastArrival && patients.nextId() > 0) {
+        time = lastArrival;
+    }
+    lastArrival = time;
+    int pid = patients.add(urgency);
+    if (patients.size() > stats.peakPatients) {
+        stats.peakPatients = patients.size();
+    }
+    eventQueue.enqueue(Event(time, TriageQueueEntrance, pid, -1));
+}
+
+// the patient is gone, late boredom events for them find nothing to do
+void DES::discharge(int pid)
+{
+    patients.remove(pid);
+}
+
+bool DES::hasEvents() const
+{
+    return !eventQueue.isEmpty() || !boredomTimers.isEmpty() || !inbox.empty();
+}
+
+int DES::nextTime()
+{
+    int next = inbox.empty() ? 2147483647 : inbox.front().time;
+    if (!eventQueue.isEmpty() && eventQueue.getFirst().time < next) {
+        next = eventQueue.getFirst().time;
+    }
+    if (!boredomTimers.isEmpty() && boredomTimers.getFirst().time < next) {
+        next = boredomTimers.getFirst().time;
+    }
+    return next;
+}
+
+// heap order of the inbox: true if a arrives after b
+static bool laterTransfer(const Transfer& a, const Transfer& b)
+{
+    if (a.time != b.time) {
+        return a.time > b.time;
+    }
+    if (a.source != b.source) {
+        return a.source > b.source;
+    }
+    return a.sourcePatient > b.sourcePatient;
+}
+
+void DES::receive(const Transfer& t)
+{
+    inbox.push_back(t);
+    std::push_heap(inbox.begin(), inbox.end(), laterTransfer);
+}
+
+// Transfers arriving by time get their ids here, in inbox order, and join
+// the doctor queue through the event set like any other patient. Doing it
+// only when the clock gets there keeps the ids independent of when the
+// transfers were delivered.
+void DES::admitTransfers(int time)
+{
+    while (!inbox.empty() && inbox.front().time <= time) {
+        Transfer t = inbox.front();
+        std::pop_heap(inbox.begin(), inbox.end(), laterTransfer);
+        inbox.pop_back();
+        int pid = patients.add(t.urgency);
+        patients[pid].arrivalTime = t.time;
+        if (patients.size() > stats.peakPatients) {
+            stats.peakPatients = patients.size();
+        }
+        stats.patientsReceived++;
+        eventQueue.enqueue(Event(t.time, DoctorQueueEntrance, pid, -1));
+    }
+}
+
+// smallest of the event set and the timing wheel, by Event::operator<
+Event DES::nextEvent()
+{
+    DES_PROFILE_TIME(profiler.nextEventTicks);
+    if (boredomTimers.isEmpty()) {
+        return eventQueue.dequeue();
+    }
+    if (eventQueue.isEmpty() || boredomTimers.getFirst() < eventQueue.getFirst()) {
+        return boredomTimers.removeSmallest();
+    }
+    return eventQueue.dequeue();
+}
+
+void DES::step()
+{
+    DES_PROFILE_SAMPLE(profiler, eventQueue.length() + boredomTimers.length());
+    if (!inbox.empty()) {
+        admitTransfers(nextTime());
+    }
+    Event e = nextEvent();
+    now = e.time;
+    if (!summaryOnly) {
+        DES_PROFILE_TIME(profiler.traceTicks);
         int res_id= e.resourceId;
         if (e.type == PatientLeaveHospital) {
             res_id = -1;
         }
-        std::cout << "[TIME " << e.time << "] Event Type: " << e.type << ", Patient Id: " << e.patientId<< ", Resource Id: " <<res_id << std::endl;
-        processEvent(e); // e is given in processEvent, so use it.
+        trace->event(Event(e.time, e.type, e.patientId, res_id));
     }
-    std::cout << "Simulation finished." << std::endl;
+    processEvent(e); // e is given in processEvent, so use it.
+    stats.eventsProcessed++;
+    stats.finishTime = e.time;
+}
+
+// the statistics that are read from the collector
+void DES::finishStatistics()
+{
+    stats.maxTriageQueue = collector.getMaxTriageQueue();
+    stats.maxDoctorQueue = collector.getMaxDoctorQueue();
+    stats.triageUtilization = collector.getTriageUtilization(stats.finishTime);
+    stats.doctorUtilization = collector.getDoctorUtilization(stats.finishTime);
+}
+
+const DESStatistics& DES::run()
+{
+    // YOUR CODE GOES HERE
+    while (hasEvents()) {
+        step();
+    }
+    finishStatistics();
+#ifdef DES_PROFILE
+    profiler.report(*profileStream, eventQueue.getProfile());
+#endif
+    if (summaryOnly) {
+        return stats;
+    }
+    trace->simulationFinished();
     
     for(int i = 0; i < numDoctors; i++){
-        std::cout << "Monotonic Stack of Doctor " << i << " is " << doctorStacks[i] << std::endl;
+        trace->doctorStack(i, doctorStacks[i]);
+    }
+    trace->flush();
+    return stats;
+}
+
+bool DES::runUntil(int time)
+{
+    while (hasEvents() && nextTime() < time) {
+        step();
+    }
+    if (time > now) {
+        now = time;
+    }
+    finishStatistics();
+    return hasEvents();
+}
+
+int DES::currentTime() const
+{
+    return now;
+}
+
+// copies from into the empty stack to, bottom first so nothing is popped
+static void copyStack(const MonotonicStack& from, MonotonicStack& to)
+{
+    int n = from.length();
+    int* ids = new int[n > 0 ? n : 1];
+    from.copyTo(ids);
+    std::reverse(ids, ids + n);
+    to.pushRange(ids, n);
+    delete[] ids;
+}
+
+int DES::addDoctor()
+{
+    int did = doctorPool.add();
+    MonotonicStack* stacks = new MonotonicStack[numDoctors + 1];
+    for (int i = 0; i < numDoctors; i++) {
+        copyStack(doctorStacks[i], stacks[i]);
+    }
+    delete[] doctorStacks;
+    doctorStacks = stacks;
+    numDoctors++;
+    collector.resourcesChanged(now, numTriages, numDoctors);
+
+    if (!doctorQueue.isEmpty()) {
+        int pid = doctorQueue.getFirst();
+        doctorQueue.dequeue();
+        PatientRecord& next = patients[pid];
+        cancelTimer(next.doctorTimer);
+        collector.doctorStarted(now, next.urgency, now - next.doctorQueueSince);
+
+        doctorPool.acquire(did);
+        eventQueue.enqueue(Event(now, DoctorEntrance, pid, did));
+    }
+    return did;
+}
+
+int DES::addTriage()
+{
+    int tid = triagePool.add();
+    numTriages++;
+    collector.resourcesChanged(now, numTriages, numDoctors);
+
+    if (!triageQueue.isEmpty()) {
+        int pid = triageQueue.dequeue();
+        PatientRecord& next = patients[pid];
+        cancelTimer(next.triageTimer);
+        collector.triageStarted(now, now - next.arrivalTime);
+
+        triagePool.acquire(tid);
+        eventQueue.enqueue(Event(now, TriageEntrance, pid, tid));
+    }
+    return tid;
+}
+
+void DES::setDurations(int tDuration, int dDuration, int bDuration)
+{
+    triageDuration = tDuration;
+    doctorVisitDuration = dDuration;
+    boringDuration = bDuration;
+}
+
+static void putTransfers(CheckpointWriter& out, const std::vector<Transfer>& transfers)
+{
+    out.putCount(transfers.size());
+    for (size_t i = 0; i < transfers.size(); i++) {
+        const Transfer& t = transfers[i];
+        out.putInt(t.time);
+        out.putInt(t.source);
+        out.putInt(t.sourcePatient);
+        out.putInt(t.destination);
+        out.putInt(t.urgency);
+    }
+}
+
+// false, and in.failed(), on a malformed list
+static bool getTransfers(CheckpointReader& in, std::vector<Transfer>& transfers)
+{
+    int n = in.getLength();
+    for (int i = 0; i < n && !in.failed(); i++) {
+        Transfer t;
+        t.time = in.getInt32();
+        t.source = in.getInt32();
+        t.sourcePatient = in.getInt32();
+        t.destination = in.getInt32();
+        t.urgency = in.getInt32();
+        transfers.push_back(t);
+    }
+    return !in.failed();
+}
+
+static bool isTimer(EventType type)
+{
+    return type == TriageQueueBoringStart || type == DoctorQueueBoringStart;
+}
+
+// Layout: magic, parameters, clock, statistics, patients, pending events
+// by time with the times as differences, queues, idle flags, doctor stacks.
+bool DES::saveCheckpoint(std::ostream& os) const
+{
+    CheckpointWriter out;
+    out.putMagic(CHECKPOINT_MAGIC);
+    out.putCount(numTriages);
+    out.putCount(numDoctors);
+    out.putCount(numTiers > 0 ? numTiers : 0);
+    out.putInt(triageDuration);
+    out.putInt(doctorVisitDuration);
+    out.putInt(boringDuration);
+    out.putCount(engine);
+    out.putBool(cancelBoredomTimers);
+    out.putBool(useTimingWheel);
+    out.putBool(summaryOnly);
+    out.putBool(arrivals != NULL);
+    out.putInt(lastArrival);
+    out.putInt(now);
+
+    out.putInt(stats.eventsProcessed);
+    out.putInt(stats.patientsTreated);
+    out.putInt(stats.patientsBored);
+    out.putInt(stats.finishTime);
+    out.putInt(stats.peakPatients);
+    out.putInt(stats.boredInTriage);
+    out.putInt(stats.boredAtDoctor);
+    out.putInt(stats.patientsTransferred);
+    out.putInt(stats.patientsReceived);
+    out.putInt(hospitalId);
+    out.putInt(transferThreshold);
+    out.putInt(transferDestination);
+    out.putInt(transferDelay);
+    collector.save(out);
+    patients.save(out);
+
+    int queued = eventQueue.length();
+    int pending = queued + boredomTimers.length();
+    Event* events = new Event[pending > 0 ? pending : 1];
+    eventQueue.copyTo(events);
+    boredomTimers.copyTo(events + queued);
+    std::sort(events, events + pending);
+    out.putCount(pending);
+    int previous = 0;
+    for (int i = 0; i < pending; i++) {
+        const Event& e = events[i];
+        out.putInt((long long)e.time - previous);
+        previous = e.time;
+        out.putCount(e.type);
+        out.putInt(e.patientId);
+        out.putInt(e.resourceId);
+        if (isTimer(e.type)) {
+            // a timer whose patient still holds its handle, the others
+            // only show up in the trace
+            bool armed = false;
+            if (patients.contains(e.patientId)) {
+                const PatientRecord& r = patients[e.patientId];
+                armed = (e.type == TriageQueueBoringStart ? r.triageTimer : r.doctorTimer) != -1;
+            }
+            out.putBool(armed);
+        }
+    }
+    delete[] events;
+
+    int longest = triageQueue.length();
+    for (int t = 0; t < numTiers; t++) {
+        if (doctorQueue.tiers[t].length() > longest) {
+            longest = doctorQueue.tiers[t].length();
+        }
+    }
+    for (int d = 0; d < numDoctors; d++) {
+        if (doctorStacks[d].length() > longest) {
+            longest = doctorStacks[d].length();
+        }
+    }
+    int* ids = new int[longest > 0 ? longest : 1];
+    triageQueue.copyTo(ids);
+    out.putCount(triageQueue.length());
+    for (int i = 0; i < triageQueue.length(); i++) {
+        out.putInt(ids[i]);
+    }
+    for (int t = 0; t < numTiers; t++) {
+        const FCFSQueue& tier = doctorQueue.tiers[t];
+        tier.copyTo(ids);
+        out.putCount(tier.length());
+        for (int i = 0; i < tier.length(); i++) {
+            out.putInt(ids[i]);
+        }
+    }
+    for (int i = 0; i < numTriages; i++) {
+        out.putBool(triagePool.isAvailable(i));
+    }
+    for (int i = 0; i < numDoctors; i++) {
+        out.putBool(doctorPool.isAvailable(i));
+    }
+    for (int d = 0; d < numDoctors; d++) {
+        doctorStacks[d].copyTo(ids);
+        out.putCount(doctorStacks[d].length());
+        for (int i = 0; i < doctorStacks[d].length(); i++) {
+            out.putInt(ids[i]);
+        }
     }
+    delete[] ids;
+    putTransfers(out, inbox);
+    putTransfers(out, outbox);
+    return out.writeTo(os);
+}
+
+DES* DES::restoreCheckpoint(std::istream& is, ArrivalSource* arrivals)
+{
+    CheckpointReader in(is);
+    if (!in.getMagic(CHECKPOINT_MAGIC)) {
+        return NULL;
+    }
+    // every triage, doctor and tier is saved with at least a byte, so
+    // getLength keeps a corrupt count from allocating much
+    int numTriages = in.getLength();
+    int numDoctors = in.getLength();
+    int numTiers = in.getLength();
+    int tDuration = in.getInt32();
+    int dDuration = in.getInt32();
+    int bDuration = in.getInt32();
+    int engine = in.getCount(IntrusiveListEngine);
+    bool cancel = in.getBool();
+    bool wheel = in.getBool();
+    bool summary = in.getBool();
+    bool streaming = in.getBool();
+    if (in.failed() || streaming != (arrivals != NULL)) {
+        return NULL;
+    }
+    DES* sim = new DES(numTriages, numDoctors, numTiers, tDuration, dDuration, bDuration,
+                       arrivals, (EventSetEngine)engine);
+    sim->cancelBoredomTimers = cancel;
+    sim->useTimingWheel = wheel;
+    sim->summaryOnly = summary;
+    if (!sim->load(in)) {
+        delete sim;
+        return NULL;
+    }
+    return sim;
+}
+
+// the part of restoreCheckpoint after the parameters
+bool DES::load(CheckpointReader& in)
+{
+    lastArrival = in.getInt32();
+    now = in.getInt32();
+    stats.eventsProcessed = in.getInt();
+    stats.patientsTreated = in.getInt32();
+    stats.patientsBored = in.getInt32();
+    stats.finishTime = in.getInt32();
+    stats.peakPatients = in.getInt32();
+    stats.boredInTriage = in.getInt32();
+    stats.boredAtDoctor = in.getInt32();
+    stats.patientsTransferred = in.getInt32();
+    stats.patientsReceived = in.getInt32();
+    hospitalId = in.getInt32();
+    transferThreshold = in.getInt32();
+    transferDestination = in.getInt32();
+    transferDelay = in.getInt32();
+    if (!collector.load(in) || !patients.load(in)) {
+        return false;
+    }
+
+    int pending = in.getLength();
+    long long time = 0;
+    for (int i = 0; i < pending && !in.failed(); i++) {
+        time += in.getInt();
+        EventType type = (EventType)in.getCount(DoctorQueueBoringStart);
+        int pid = in.getInt32();
+        int rid = in.getInt32();
+        if (time < -2147483647LL - 1 || time > 2147483647LL) {
+            in.fail();
+        }
+        if (!isTimer(type)) {
+            eventQueue.enqueue(Event((int)time, type, pid, rid));
+            continue;
+        }
+        bool armed = in.getBool();
+        if (in.failed() || (armed && !patients.contains(pid))) {
+            in.fail();
+            break;
+        }
+        int handle = scheduleTimer(Event((int)time, type, pid, rid));
+        if (armed) {
+            PatientRecord& r = patients[pid];
+            (type == TriageQueueBoringStart ? r.triageTimer : r.doctorTimer) = handle;
+        }
+    }
+
+    // queued patients have to be in the table, processEvent trusts that
+    int waiting = in.getLength();
+    for (int i = 0; i < waiting && !in.failed(); i++) {
+        int pid = in.getInt32();
+        if (!patients.contains(pid)) {
+            in.fail();
+            break;
+        }
+        triageQueue.enqueue(pid);
+    }
+    for (int t = 0; t < numTiers && !in.failed(); t++) {
+        waiting = in.getLength();
+        for (int i = 0; i < waiting && !in.failed(); i++) {
+            int pid = in.getInt32();
+            if (!patients.contains(pid)) {
+                in.fail();
+                break;
+            }
+            doctorQueue.enqueue(pid, t);
+        }
+    }
+    for (int i = 0; i < numTriages; i++) {
+        if (!in.getBool()) {
+            triagePool.acquire(i);
+        }
+    }
+    for (int i = 0; i < numDoctors; i++) {
+        if (!in.getBool()) {
+            doctorPool.acquire(i);
+        }
+    }
+    for (int d = 0; d < numDoctors && !in.failed(); d++) {
+        // saved top first
+        int n = in.getLength();
+        int* ids = new int[n > 0 ? n : 1];
+        for (int i = n - 1; i >= 0; i--) {
+            ids[i] = in.getInt32();
+        }
+        doctorStacks[d].pushRange(ids, n);
+        delete[] ids;
+    }
+    std::vector<Transfer> arriving;
+    if (getTransfers(in, arriving)) {
+        for (size_t i = 0; i < arriving.size(); i++) {
+            receive(arriving[i]);
+        }
+    }
+    getTransfers(in, outbox);
+    finishStatistics();
+    return !in.failed() && in.atEnd();
+}
+
+DES* DES::fork() const
+{
+    if (arrivals != NULL) {
+        return NULL;
+    }
+    std::stringstream buffer;
+    if (!saveCheckpoint(buffer)) {
+        return NULL;
+    }
+    return restoreCheckpoint(buffer);
 }
 
 void DES::processEvent(const Event& e)
 {
     // YOUR CODE GOES HERE
+    DES_PROFILE_EVENT(profiler, e.type);
     if (e.type == TriageQueueEntrance)
     {
+        // the next patient arrives at or after this one.
+        admitNext();
+
         triageQueue.enqueue(e.patientId);
+        patients[e.patientId].arrivalTime = e.time;
 
         // we check boredom.
-        eventQueue.enqueue(Event(e.time + boringDuration, TriageQueueBoringStart, e.patientId, -1));
+        patients[e.patientId].triageTimer = scheduleTimer(Event(e.time + boringDuration, TriageQueueBoringStart, e.patientId, -1));
 
-        // passing to available triages.
-        for (int i = 0; i < numTriages; i++) {
-            if (triageAvailable[i] && !(triageQueue.isEmpty())) {
-                triageAvailable[i] = false;
-                triageQueue.dequeue();
+        // passing to the first available triage.
+        if (!(triageQueue.isEmpty())) {
+            int i = triagePool.acquire();
+            if (i != -1) {
+                PatientRecord& patient = patients[triageQueue.dequeue()];
+                cancelTimer(patient.triageTimer);
+                collector.triageStarted(e.time, e.time - patient.arrivalTime);
 
                 // triage entrance scheduling.
                 eventQueue.enqueue(Event(e.time, TriageEntrance, e.patientId, i));
-                break;
             }
         }
+        // counted after the dispatch, so nobody seen at once counts as queued.
+        collector.triageQueueJoined(e.time);
     }
     else if (e.type == TriageEntrance)
     {
@@ -96,42 +709,64 @@ void DES::processEvent(const Event& e)
     // now leave triage
     else if (e.type == TriageLeave)
     {
-        triageAvailable[e.resourceId] = true;
+        triagePool.release(e.resourceId);
+        collector.triageFinished(e.time);
 
-        // then we will go to doctors, after scheduled.
-        eventQueue.enqueue(Event(e.time, DoctorQueueEntrance, e.patientId, -1));
+        int tier = patients[e.patientId].urgency;
+        if (transferThreshold >= 0 && tier >= 0 && tier < numTiers
+            && doctorQueue.tiers[tier].length() >= transferThreshold) {
+            // too many wait in their tier here, they go on to another hospital
+            Transfer t = {e.time + transferDelay, hospitalId, e.patientId, transferDestination, tier};
+            outbox.push_back(t);
+            stats.patientsTransferred++;
+            eventQueue.enqueue(Event(e.time, PatientLeaveHospital, e.patientId, -1));
+        }
+        else {
+            // then we will go to doctors, after scheduled.
+            eventQueue.enqueue(Event(e.time, DoctorQueueEntrance, e.patientId, -1));
+        }
 
         // next triage
-        for (int i = 0; i < numTriages; i++) {
-            if (triageAvailable[i] && !(triageQueue.isEmpty())) {
+        if (!(triageQueue.isEmpty())) {
+            int i = triagePool.acquire();
+            if (i != -1) {
                 int pid = triageQueue.getFirst();
                 triageQueue.dequeue();
-                triageAvailable[i] = false;
+                cancelTimer(patients[pid].triageTimer);
+                collector.triageStarted(e.time, e.time - patients[pid].arrivalTime);
 
                 eventQueue.enqueue(Event(e.time, TriageEntrance, pid, i));
-                break;
             }
         }
     }
     else if (e.type == DoctorQueueEntrance)
     {
-        int tier = urgencyLevels[e.patientId];
+        PatientRecord& patient = patients[e.patientId];
+        int tier = patient.urgency;
         doctorQueue.enqueue(e.patientId, tier);
+        patient.doctorQueueSince = e.time;
 
         // we stated that person can get bored at doctors too
-        eventQueue.enqueue(Event(e.time + boringDuration, DoctorQueueBoringStart, e.patientId, -1));
+        patient.doctorTimer = scheduleTimer(Event(e.time + boringDuration, DoctorQueueBoringStart, e.patientId, -1));
+        if (tier < 0 || tier >= numTiers) {
+            // no queue took this patient, they are not seen again.
+            discharge(e.patientId);
+        }
 
         // then lets go to doctors office, if available
-        for (int i = 0; i < numDoctors; i++) {
-            if (doctorAvailable[i] && !doctorQueue.isEmpty()) {
+        if (!doctorQueue.isEmpty()) {
+            int i = doctorPool.acquire();
+            if (i != -1) {
                 int pid = doctorQueue.getFirst();
                 doctorQueue.dequeue();
-                doctorAvailable[i] = false;
+                PatientRecord& next = patients[pid];
+                cancelTimer(next.doctorTimer);
+                collector.doctorStarted(e.time, next.urgency, e.time - next.doctorQueueSince);
 
                 eventQueue.enqueue(Event(e.time, DoctorEntrance, pid, i));
-                break;
             }
         }
+        collector.doctorQueueJoined(e.time, tier);
     }
     else if (e.type == DoctorEntrance)
     {
@@ -143,14 +778,24 @@ void DES::processEvent(const Event& e)
         int did = e.resourceId;
         int pid = e.patientId;
         if(did != -1){
-            doctorAvailable[did] = true;
-            doctorStacks[did].push(pid);
+            collector.doctorFinished(e.time, e.time - patients[pid].arrivalTime);
+        }
+        discharge(pid);
+        if(did != -1){
+            doctorPool.release(did);
+            if (!summaryOnly) {
+                doctorStacks[did].push(pid);
+            }
+            stats.patientsTreated++;
             
             if (!(doctorQueue.isEmpty())) {
                 int nextPid = doctorQueue.getFirst();
                 doctorQueue.dequeue();
-                
-                doctorAvailable[did] = false;
+                PatientRecord& next = patients[nextPid];
+                cancelTimer(next.doctorTimer);
+                collector.doctorStarted(e.time, next.urgency, e.time - next.doctorQueueSince);
+
+                doctorPool.acquire(did);
                 eventQueue.enqueue(Event(e.time, DoctorEntrance, nextPid, did));
             }
         }
@@ -158,23 +803,36 @@ void DES::processEvent(const Event& e)
     else if (e.type == TriageQueueBoringStart)
     {
         int pid = e.patientId;
+        if (!patients.contains(pid)) {
+            return;
+        }
+        patients[pid].triageTimer = -1; // this is the timer, it is gone now
 
         if (!(triageQueue.isEmpty()) && triageQueue.getLast() == pid) {
             // Patient leaves the hospital due to boredom
             triageQueue.removeBack(); //removing the person.
+            stats.patientsBored++;
+            stats.boredInTriage++;
+            collector.triageQueueBored(e.time, patients[pid].urgency);
             eventQueue.enqueue(Event(e.time, PatientLeaveHospital, pid, -1));
         }
     }
     else if (e.type == DoctorQueueBoringStart)
     {
         int pid = e.patientId;
+        if (!patients.contains(pid)) {
+            return;
+        }
+        patients[pid].doctorTimer = -1;
 
-        for (int i = numTiers - 1; i >= 0; i--) {
-            if (!(doctorQueue.tiers[i].isEmpty()) && doctorQueue.tiers[i].getLast() == pid) {
-                doctorQueue.tiers[i].removeBack(); // remove by the help of friend functionality.
-                eventQueue.enqueue(Event(e.time, PatientLeaveHospital, pid, -1));
-                break;
-            }
+        // the patient can only be waiting in its own urgency tier.
+        int tier = patients[pid].urgency;
+        if (doctorQueue.getLast(tier) == pid) {
+            doctorQueue.removeBack(tier);
+            stats.patientsBored++;
+            stats.boredAtDoctor++;
+            collector.doctorQueueBored(e.time, tier);
+            eventQueue.enqueue(Event(e.time, PatientLeaveHospital, pid, -1));
         }
     }
 }
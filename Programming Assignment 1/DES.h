@@ -5,9 +5,46 @@
 #include "TieredFCFSQueue.h"
 #include "FCFSQueue.h"
 #include "MonotonicStack.h"
+#include "ResourcePool.h"
+#include "TimingWheel.h"
+#include "TraceSink.h"
+#include "PatientTable.h"
+#include "ArrivalSource.h"
+#include "StatisticsCollector.h"
+#include "DESProfiler.h"
+#include "Checkpoint.h"
+#include <vector>
 
 using namespace std;
 
+// What a finished run() did, for runs whose trace nobody reads.
+struct DESStatistics
+{
+    long long eventsProcessed;
+    int patientsTreated; // left after a doctor visit
+    int patientsBored;   // left from the triage or doctor queue
+    int finishTime;      // time of the last event, -1 if there was none
+    int peakPatients;    // most patients in the hospital at once
+    int boredInTriage;   // of patientsBored, left from the triage queue
+    int boredAtDoctor;   // of patientsBored, left from the doctor queue
+    int maxTriageQueue;  // longest the triage queue got
+    int maxDoctorQueue;  // longest the doctor queue got, all tiers together
+    double triageUtilization; // busy share of the triage nurses
+    double doctorUtilization;
+    int patientsTransferred; // sent to another hospital after triage
+    int patientsReceived;    // came from another hospital
+};
+
+// A patient on the way to another hospital of a HospitalNetwork.
+struct Transfer
+{
+    int time; // arrival at the destination
+    int source; // hospital indices in the network
+    int sourcePatient;
+    int destination;
+    int urgency;
+};
+
 class DES
 {
 private:
@@ -16,18 +53,110 @@ private:
     FCFSQueue triageQueue;
     TieredFCFSQueue doctorQueue;
     PriorityQueue eventQueue;
-    bool* triageAvailable;
-    bool* doctorAvailable;
+    TimingWheel boredomTimers; // *BoringStart events when useTimingWheel is set
+    ResourcePool triagePool; // idle triage nurses
+    ResourcePool doctorPool; // idle doctors
     MonotonicStack* doctorStacks;
-    int *urgencyLevels;
-    
+    PatientTable patients; // urgency, timers, ... of the patients inside
+    ArrivalSource* arrivals; // NULL when every arrival was enqueued up front
+    int lastArrival;
+    EventSetEngine engine;
+    int now; // time of the last event, or where runUntil stopped
+    bool cancelBoredomTimers;
+    bool useTimingWheel;
+    StatisticsCollector collector;
+    bool summaryOnly;
+    OStreamTraceSink streamSink; // std::cout unless setOutputStream is called
+    TraceSink* trace; // streamSink unless setTraceSink is called
+    DESStatistics stats;
+    // transfers, set up by HospitalNetwork
+    int hospitalId;
+    int transferThreshold; // -1: nobody is transferred
+    int transferDestination;
+    int transferDelay;
+    std::vector<Transfer> inbox;  // heap, the earliest arrival on top
+    std::vector<Transfer> outbox; // sent since the network last collected
+#ifdef DES_PROFILE
+    DESProfiler profiler;
+    std::ostream* profileStream; // std::cerr unless setProfileStream is called
+#endif
+
+    DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
+    ArrivalSource* arrivals, EventSetEngine engine);
+    void admitNext();
+    void discharge(int pid);
+    int scheduleTimer(const Event& timer);
+    void cancelTimer(int& timer);
+    bool hasEvents() const;
+    int nextTime(); // of the next event or transfer, hasEvents() must hold
+    void admitTransfers(int time);
+    void receive(const Transfer& t);
+    Event nextEvent();
+    void step();
+    void finishStatistics();
+    bool load(CheckpointReader& in);
+
+    friend class HospitalNetwork;
 
 public:
     DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
-    int numPatients, int* urgencyLevels, int *patientArrivalTimes);
+    int numPatients, const int* urgencyLevels, const int *patientArrivalTimes, EventSetEngine engine = HeapEngine);
+    // Patients are read from arrivals one at a time, each when the one
+    // before it arrives, so only the patients inside the hospital take
+    // memory. Arrivals have to be sorted by time; an earlier time than the
+    // previous patient's counts as arriving together with them.
+    DES(int numTriages, int numDoctors, int numTiers, int tDuration, int dDuration, int bDuration,
+    ArrivalSource& arrivals, EventSetEngine engine = HeapEngine);
     ~DES();
-    void run();
+    // Cancel a patient's boredom event once they leave the queue. Off by
+    // default, because the cancelled events no longer show up in the trace.
+    void setCancelBoredomTimers(bool cancel);
+    // Keep boredom events on a TimingWheel instead of the event set (the
+    // default). Either way the trace is the same. Call before run().
+    void setTimingWheel(bool use);
+    void setOutputStream(std::ostream& os);
+    void setTraceSink(TraceSink& sink); // caller keeps ownership
+    // Only collect statistics: no trace, not even the doctor stacks.
+    void setSummaryOnly(bool summaryOnly);
+    const DESStatistics& getStatistics() const;
+    // wait and stay histograms, bored patients per tier, ...
+    const StatisticsCollector& getCollector() const;
+    // mean doctor queue wait of the tier's patients who saw a doctor,
+    // -1 if there were none
+    double getMeanWait(int tier) const;
+#ifdef DES_PROFILE
+    // where run() reports the profile when it is done
+    void setProfileStream(std::ostream& os);
+    const DESProfiler& getProfiler() const;
+#endif
+    const DESStatistics& run();
+    // Processes the events before time and stops, so the simulation can be
+    // checkpointed or changed at time. false once there is nothing left;
+    // run() finishes it either way.
+    bool runUntil(int time);
+    int currentTime() const;
     void processEvent(const Event& e);
+
+    // What-if changes, from currentTime() on. A new doctor or nurse takes
+    // the first waiting patient at once; the durations apply to events
+    // scheduled from now, not to the ones already pending.
+    int addDoctor(); // the new doctor's id
+    int addTriage();
+    void setDurations(int tDuration, int dDuration, int bDuration);
+
+    // The whole simulation state in a compact binary form: clock, pending
+    // events, queues, idle resources, doctor stacks, patients, statistics
+    // and transfers in flight. The trace sink, output stream and arrival
+    // source are not part of it. false if the stream failed.
+    bool saveCheckpoint(std::ostream& os) const;
+    // A new simulation continuing from a checkpoint, NULL if it is
+    // malformed. A streaming simulation needs its arrival source back,
+    // positioned after the last patient it admitted; others take none.
+    static DES* restoreCheckpoint(std::istream& is, ArrivalSource* arrivals = NULL);
+    // An independent copy of this simulation, NULL for a streaming one
+    // since the arrival source cannot be copied. The copy writes its trace
+    // to std::cout until told otherwise.
+    DES* fork() const;
 };
 
 #endif
\ No newline at end of file
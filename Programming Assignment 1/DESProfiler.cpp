@@ -0,0 +1,98 @@
+#include "DESProfiler.h"
+
+#ifdef DES_PROFILE
+
+#include <iomanip>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+
+static const char* TICK_UNIT = "TSC ticks";
+
+unsigned long long profileTicks()
+{
+    return __rdtsc();
+}
+#else
+#include <chrono>
+
+static const char* TICK_UNIT = "ns";
+
+unsigned long long profileTicks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+static const char* EVENT_NAMES[8] = {
+    "TriageQueueEntrance", "TriageEntrance", "TriageLeave", "DoctorQueueEntrance",
+    "DoctorEntrance", "PatientLeaveHospital", "TriageQueueBoringStart", "DoctorQueueBoringStart"
+};
+
+static double perOp(unsigned long long ticks, long long ops)
+{
+    return ops == 0 ? 0.0 : (double)ticks / ops;
+}
+
+DESProfiler::DESProfiler()
+{
+    for (int i = 0; i < NUM_EVENT_TYPES; i++) {
+        eventCount[i] = 0;
+        eventTicks[i] = 0;
+    }
+    sizeSamples = 0;
+    sizeTotal = 0;
+    maxSize = 0;
+    nextEventTicks = 0;
+    traceTicks = 0;
+    timerSchedules = 0;
+    timerCancels = 0;
+    timerTicks = 0;
+}
+
+void DESProfiler::sampleSize(int pending)
+{
+    sizeSamples++;
+    sizeTotal += pending;
+    if (pending > maxSize) {
+        maxSize = pending;
+    }
+}
+
+void DESProfiler::report(std::ostream& os, const QueueProfile& queue) const
+{
+    long long events = 0;
+    unsigned long long ticks = 0;
+    for (int i = 0; i < NUM_EVENT_TYPES; i++) {
+        events += eventCount[i];
+        ticks += eventTicks[i];
+    }
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    os << "DES profile, " << events << " events, times in " << TICK_UNIT << std::endl;
+    os << std::left << std::setw(24) << "event type" << std::right << std::setw(14) << "count"
+       << std::setw(16) << "ticks" << std::setw(9) << "share" << std::setw(14) << "ticks/event" << std::endl;
+    for (int i = 0; i < NUM_EVENT_TYPES; i++) {
+        os << std::left << std::setw(24) << EVENT_NAMES[i] << std::right << std::setw(14) << eventCount[i]
+           << std::setw(16) << eventTicks[i] << std::setw(8) << (ticks == 0 ? 0.0 : 100.0 * eventTicks[i] / ticks)
+           << "%" << std::setw(14) << perOp(eventTicks[i], eventCount[i]) << std::endl;
+    }
+    os << std::left << std::setw(24) << "processEvent" << std::right << std::setw(14) << events
+       << std::setw(16) << ticks << std::setw(9) << "" << std::setw(14) << perOp(ticks, events) << std::endl;
+    os << "next event: " << perOp(nextEventTicks, events) << " ticks/event, trace: "
+       << perOp(traceTicks, events) << " ticks/event" << std::endl;
+    os << "pending events: mean " << (sizeSamples == 0 ? 0.0 : (double)sizeTotal / sizeSamples)
+       << ", max " << maxSize << std::endl;
+    long long queueOps = queue.enqueues + queue.dequeues + queue.cancels + queue.peeks;
+    os << "event set: " << queue.enqueues << " enqueues, " << queue.dequeues << " dequeues, "
+       << queue.cancels << " cancels, " << queue.peeks << " peeks, " << perOp(queue.ticks, queueOps)
+       << " ticks/op" << std::endl;
+    os << "timing wheel: " << timerSchedules << " schedules, " << timerCancels << " cancels, "
+       << perOp(timerTicks, timerSchedules + timerCancels) << " ticks/op" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+#endif
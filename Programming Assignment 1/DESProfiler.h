@@ -0,0 +1,86 @@
+#ifndef DESPROFILER_H
+#define DESPROFILER_H
+
+// Hot path counters for DES::run, only compiled in with -DDES_PROFILE.
+// Without it the DES_PROFILE_* macros expand to nothing and none of the
+// classes below exist, so a normal build pays nothing.
+//
+// Times are in ticks of profileTicks(): the time stamp counter on x86,
+// nanoseconds elsewhere. Every timed section reads it twice, which costs
+// about as much as a small event set operation, so compare the numbers
+// with each other rather than with an unprofiled run.
+
+#ifdef DES_PROFILE
+
+#include "Event.h"
+#include <iostream>
+
+unsigned long long profileTicks();
+
+// adds the ticks from construction to destruction to total
+class ProfileTimer {
+private:
+    unsigned long long& total;
+    unsigned long long start;
+
+    ProfileTimer(const ProfileTimer& other); // not copyable
+    ProfileTimer& operator=(const ProfileTimer& other);
+
+public:
+    ProfileTimer(unsigned long long& total) : total(total), start(profileTicks()) {}
+    ~ProfileTimer() { total += profileTicks() - start; }
+};
+
+// operations on a PriorityQueue, kept by the queue itself
+struct QueueProfile
+{
+    long long enqueues;
+    long long dequeues;
+    long long cancels;
+    long long peeks; // getFirst and getLast
+    unsigned long long ticks;
+};
+
+class DESProfiler {
+private:
+    static const int NUM_EVENT_TYPES = 8;
+
+    long long eventCount[NUM_EVENT_TYPES];
+    unsigned long long eventTicks[NUM_EVENT_TYPES]; // processEvent, inclusive
+    long long sizeSamples;
+    long long sizeTotal; // pending events, summed before every event
+    int maxSize;
+
+public:
+    // time outside processEvent
+    unsigned long long nextEventTicks; // picking the next event
+    unsigned long long traceTicks;     // handing it to the TraceSink
+    // the boredom timing wheel
+    long long timerSchedules;
+    long long timerCancels;
+    unsigned long long timerTicks; // schedule and cancel
+
+    DESProfiler();
+    void sampleSize(int pending);
+    long long& count(EventType type) { return eventCount[type]; }
+    unsigned long long& ticks(EventType type) { return eventTicks[type]; }
+    void report(std::ostream& os, const QueueProfile& queue) const;
+};
+
+#define DES_PROFILE_TIME(total) ProfileTimer desProfileTimer(total)
+#define DES_PROFILE_COUNT(counter) ((counter)++)
+#define DES_PROFILE_EVENT(profiler, type) \
+    (profiler).count(type)++; \
+    ProfileTimer desProfileTimer((profiler).ticks(type))
+#define DES_PROFILE_SAMPLE(profiler, pending) (profiler).sampleSize(pending)
+
+#else
+
+#define DES_PROFILE_TIME(total)
+#define DES_PROFILE_COUNT(counter)
+#define DES_PROFILE_EVENT(profiler, type)
+#define DES_PROFILE_SAMPLE(profiler, pending)
+
+#endif
+
+#endif
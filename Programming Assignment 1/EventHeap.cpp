@@ -0,0 +1,209 @@
+#include "EventHeap.h"
+
+// children of i are 4i+1 .. 4i+4, parent of i is (i-1)/4
+static const int ARITY = 4;
+
+EventHeap::EventHeap()
+{
+    heap = NULL;
+    handleAt = NULL;
+    positionOf = NULL;
+    freeHandles = NULL;
+    numFree = 0;
+    count = 0;
+    capacity = 0;
+}
+
+EventHeap::~EventHeap()
+{
+    delete[] heap;
+    delete[] handleAt;
+    delete[] positionOf;
+    delete[] freeHandles;
+}
+
+void EventHeap::grow()
+{
+    // there is one handle per event, so handles live in [0, capacity).
+    int newCapacity = (capacity == 0) ? 16 : capacity * 2;
+    EventKey* biggerHeap = new EventKey[newCapacity];
+    int* biggerHandleAt = new int[newCapacity];
+    int* biggerPositionOf = new int[newCapacity];
+    int* biggerFree = new int[newCapacity];
+    for (int i = 0; i < count; i++) {
+        biggerHeap[i] = heap[i];
+        biggerHandleAt[i] = handleAt[i];
+    }
+    for (int h = 0; h < capacity; h++) {
+        biggerPositionOf[h] = positionOf[h];
+    }
+    for (int h = capacity; h < newCapacity; h++) {
+        biggerPositionOf[h] = -1;
+    }
+    // the heap is full, so no handle is free. Lowest new handles go on top.
+    numFree = 0;
+    for (int h = newCapacity - 1; h >= capacity; h--) {
+        biggerFree[numFree] = h;
+        numFree++;
+    }
+    delete[] heap;
+    delete[] handleAt;
+    delete[] positionOf;
+    delete[] freeHandles;
+    heap = biggerHeap;
+    handleAt = biggerHandleAt;
+    positionOf = biggerPositionOf;
+    freeHandles = biggerFree;
+    capacity = newCapacity;
+}
+
+void EventHeap::place(int i, const EventKey& key, int handle)
+{
+    heap[i] = key;
+    handleAt[i] = handle;
+    positionOf[handle] = i;
+}
+
+void EventHeap::siftUp(int i)
+{
+    // hole technique, we move parents down instead of swapping every level.
+    EventKey moving = heap[i];
+    int movingHandle = handleAt[i];
+    while (i > 0) {
+        int parent = (i - 1) / ARITY;
+        if (!(moving < heap[parent])) {
+            break;
+        }
+        place(i, heap[parent], handleAt[parent]);
+        i = parent;
+    }
+    place(i, moving, movingHandle);
+}
+
+void EventHeap::siftDown(int i)
+{
+    EventKey moving = heap[i];
+    int movingHandle = handleAt[i];
+    while (true) {
+        int first = i * ARITY + 1;
+        if (first >= count) {
+            break;
+        }
+        int last = first + ARITY;
+        if (last > count) {
+            last = count;
+        }
+        int smallest = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap[c] < heap[smallest]) {
+                smallest = c;
+            }
+        }
+        if (!(heap[smallest] < moving)) {
+            break;
+        }
+        place(i, heap[smallest], handleAt[smallest]);
+        i = smallest;
+    }
+    place(i, moving, movingHandle);
+}
+
+void EventHeap::removeAt(int i)
+{
+    positionOf[handleAt[i]] = -1;
+    freeHandles[numFree] = handleAt[i];
+    numFree++;
+    count--;
+    if (i == count) {
+        return;
+    }
+    // fill the hole with the last event, it may have to go either way.
+    place(i, heap[count], handleAt[count]);
+    if (i > 0 && heap[i] < heap[(i - 1) / ARITY]) {
+        siftUp(i);
+    }
+    else {
+        siftDown(i);
+    }
+}
+
+void EventHeap::add(const Event& data)
+{
+    addCancellable(data);
+}
+
+int EventHeap::addCancellable(const Event& data)
+{
+    if (count == capacity) {
+        grow();
+    }
+    numFree--;
+    int handle = freeHandles[numFree];
+    place(count, EventKey(data), handle);
+    count++;
+    siftUp(count - 1);
+    return handle;
+}
+
+bool EventHeap::cancel(int handle)
+{
+    if (handle < 0 || handle >= capacity || positionOf[handle] == -1) {
+        return false;
+    }
+    removeAt(positionOf[handle]);
+    return true;
+}
+
+Event EventHeap::removeSmallest()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    Event smallest = heap[0].event();
+    removeAt(0);
+    return smallest;
+}
+
+bool EventHeap::isEmpty() const
+{
+    return count == 0;
+}
+
+int EventHeap::length() const
+{
+    return count;
+}
+
+Event EventHeap::getFirst() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    return heap[0].event();
+}
+
+Event EventHeap::getLast() const
+{
+    // the largest event is one of the leaves, so only scan those.
+    if (isEmpty()) {
+        return Event();
+    }
+    int firstLeaf = (count - 2) / ARITY + 1;
+    if (count == 1) {
+        firstLeaf = 0;
+    }
+    int largest = firstLeaf;
+    for (int i = firstLeaf + 1; i < count; i++) {
+        if (heap[largest] < heap[i]) {
+            largest = i;
+        }
+    }
+    return heap[largest].event();
+}
+
+void EventHeap::copyTo(Event* out) const
+{
+    for (int i = 0; i < count; i++) {
+        out[i] = heap[i].event();
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef EVENTHEAP_H
+#define EVENTHEAP_H
+
+#include "EventSet.h"
+#include "EventKey.h"
+
+// Array backed 4-ary min heap of events, ordered by Event::operator<.
+// 4 children per node keeps the heap shallow and a sift down touches
+// one cache line of children instead of chasing list pointers.
+// The heap is indexed: every event gets a handle that remembers where the
+// event sits in the heap, so it can be cancelled in O(log n).
+// Events are stored as EventKeys, in parallel arrays with their handles,
+// so a sift compares and moves plain integers.
+class EventHeap : public EventSet {
+private:
+    EventKey* heap;
+    int* handleAt;   // handle of the event in heap[i]
+    int* positionOf; // slot in heap of handle h, -1 if h is not in use
+    int* freeHandles; // released handles, used as a stack
+    int numFree;
+    int count;
+    int capacity;
+
+    void grow();
+    void place(int i, const EventKey& key, int handle);
+    void siftUp(int i);
+    void siftDown(int i);
+    void removeAt(int i);
+
+    EventHeap(const EventHeap& other); // not copyable
+    EventHeap& operator=(const EventHeap& other);
+
+public:
+    EventHeap();
+    ~EventHeap();
+    void add(const Event& data);
+    int addCancellable(const Event& data);
+    bool cancel(int handle);
+    Event removeSmallest();
+    bool isEmpty() const;
+    int length() const;
+    Event getFirst() const;
+    Event getLast() const;
+    void copyTo(Event* out) const;
+};
+
+#endif
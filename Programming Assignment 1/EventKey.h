@@ -0,0 +1,67 @@
+#ifndef EVENTKEY_H
+#define EVENTKEY_H
+
+#include "Event.h"
+
+// An Event packed into one 128-bit integer whose order is exactly
+// Event::operator<, so comparing two events is one integer compare
+// instead of up to four branches. From the most significant end:
+//
+//   bits 96..127 time, 64..95 patientId, 32..63 type, 0..31 resourceId
+//
+// Every int goes in with its sign bit flipped, which turns signed order
+// into unsigned order. Nothing is dropped, so the key holds the whole
+// event and event() gives it back; the event set engines store keys and
+// hand out Events as views of them. A key is plain data: copying it is a
+// 16 byte move, not a call to Event's copy constructor.
+class EventKey {
+private:
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Bits;
+    Bits bits;
+
+    unsigned int field(int shift) const { return (unsigned int)(bits >> shift); }
+#else
+    unsigned long long high; // time, patientId
+    unsigned long long low;  // type, resourceId
+
+    unsigned int field(int shift) const
+    {
+        return (unsigned int)((shift >= 64 ? high : low) >> (shift & 63));
+    }
+#endif
+
+    static unsigned int flip(int v) { return (unsigned int)v ^ 0x80000000u; }
+    static int unflip(unsigned int u) { return (int)(u ^ 0x80000000u); }
+
+public:
+    EventKey() { *this = EventKey(-1, TriageQueueEntrance, -1, -1); } // Event()
+    EventKey(int time, EventType type, int patientId, int resourceId)
+    {
+#if defined(__SIZEOF_INT128__)
+        bits = ((Bits)flip(time) << 96) | ((Bits)flip(patientId) << 64)
+             | ((Bits)flip(type) << 32) | flip(resourceId);
+#else
+        high = ((unsigned long long)flip(time) << 32) | flip(patientId);
+        low = ((unsigned long long)flip(type) << 32) | flip(resourceId);
+#endif
+    }
+    explicit EventKey(const Event& e) { *this = EventKey(e.time, e.type, e.patientId, e.resourceId); }
+
+    int time() const { return unflip(field(96)); }
+    int patientId() const { return unflip(field(64)); }
+    EventType type() const { return (EventType)unflip(field(32)); }
+    int resourceId() const { return unflip(field(0)); }
+    Event event() const { return Event(time(), type(), patientId(), resourceId()); }
+
+    bool operator<(const EventKey& other) const
+    {
+#if defined(__SIZEOF_INT128__)
+        return bits < other.bits;
+#else
+        return high < other.high || (high == other.high && low < other.low);
+#endif
+    }
+};
+
+#endif
@@ -0,0 +1,23 @@
+#include "EventSet.h"
+#include "EventHeap.h"
+#include "SortedLinkedList.h"
+#include "CalendarQueue.h"
+#include "RadixHeap.h"
+#include "IntrusiveSortedList.h"
+
+EventSet* EventSet::create(EventSetEngine engine)
+{
+    if (engine == SortedListEngine) {
+        return new SortedLinkedList();
+    }
+    if (engine == CalendarEngine) {
+        return new CalendarQueue();
+    }
+    if (engine == RadixEngine) {
+        return new RadixHeap();
+    }
+    if (engine == IntrusiveListEngine) {
+        return new IntrusiveSortedList();
+    }
+    return new EventHeap();
+}
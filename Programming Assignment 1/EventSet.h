@@ -0,0 +1,48 @@
+#ifndef EVENTSET_H
+#define EVENTSET_H
+
+#include "Event.h"
+
+// Engines that PriorityQueue can run on. DES picks one at construction.
+enum EventSetEngine
+{
+    HeapEngine,         // EventHeap, 4-ary array heap (default)
+    SortedListEngine,   // SortedLinkedList, the original O(n) insert list
+    CalendarEngine,     // CalendarQueue, time bucketed, O(1) amortized
+    RadixEngine,        // RadixHeap, needs monotone times like DES produces
+    IntrusiveListEngine // IntrusiveSortedList, sorted list with O(1) cancel
+};
+
+// Common interface of the pending event set engines.
+// Every engine must hand events back in Event::operator< order.
+class EventSet {
+public:
+    virtual ~EventSet() {}
+    virtual void add(const Event& data) = 0;
+    virtual Event removeSmallest() = 0;
+    virtual bool isEmpty() const = 0;
+    virtual int length() const = 0;
+    virtual Event getFirst() const = 0;
+    virtual Event getLast() const = 0;
+    // writes the length() pending events to out, in no particular order
+    virtual void copyTo(Event* out) const = 0;
+
+    // Engines that can take an event back out return a handle for it,
+    // valid until the event is removed or cancelled. The rest return -1
+    // and cancel always fails.
+    virtual int addCancellable(const Event& data)
+    {
+        add(data);
+        return -1;
+    }
+    virtual bool cancel(int handle)
+    {
+        (void)handle;
+        return false;
+    }
+
+    // creates the engine, caller owns the returned object.
+    static EventSet* create(EventSetEngine engine);
+};
+
+#endif
@@ -1,35 +1,97 @@
 #include "FCFSQueue.h"
 
+// like LinkedList<int>, an empty queue answers 0.
+
+FCFSQueue::FCFSQueue()
+{
+    patients = NULL;
+    capacity = 0;
+    head = 0;
+    count = 0;
+}
+
+FCFSQueue::~FCFSQueue()
+{
+    delete[] patients;
+}
+
+void FCFSQueue::grow()
+{
+    int newCapacity = (capacity == 0) ? 8 : capacity * 2;
+    int* bigger = new int[newCapacity];
+    // unwrap so the first patient lands at index 0.
+    for (int i = 0; i < count; i++) {
+        bigger[i] = patients[(head + i) & (capacity - 1)];
+    }
+    delete[] patients;
+    patients = bigger;
+    capacity = newCapacity;
+    head = 0;
+}
+
 void FCFSQueue::enqueue(int patientId)
 {
     // YOUR CODE GOES HERE
-    patients.addBack(patientId);
+    if (count == capacity) {
+        grow();
+    }
+    patients[(head + count) & (capacity - 1)] = patientId;
+    count++;
 }
 
 int FCFSQueue::dequeue()
 {
     // YOUR CODE GOES HERE
-    return patients.removeFront();
+    if (isEmpty()) {
+        return 0;
+    }
+    int patientId = patients[head];
+    head = (head + 1) & (capacity - 1);
+    count--;
+    return patientId;
 }
 
 bool FCFSQueue::isEmpty() const
 {
     // YOUR CODE GOES HERE
-    return patients.isEmpty();
+    return count == 0;
+}
+
+int FCFSQueue::length() const
+{
+    return count;
 }
 
 int FCFSQueue::getFirst() const
 {
     // YOUR CODE GOES HERE
-    return patients.getFront();
+    if (isEmpty()) {
+        return 0;
+    }
+    return patients[head];
 }
 
 int FCFSQueue::getLast() const
 {
     // YOUR CODE GOES HERE
-    return patients.getBack();
+    if (isEmpty()) {
+        return 0;
+    }
+    return patients[(head + count - 1) & (capacity - 1)];
 }
+
 int FCFSQueue::removeBack()
 {
-    return patients.removeBack();
+    if (isEmpty()) {
+        return 0;
+    }
+    count--;
+    return patients[(head + count) & (capacity - 1)];
+}
+
+void FCFSQueue::copyTo(int* out) const
+{
+    for (int i = 0; i < count; i++) {
+        out[i] = patients[(head + i) & (capacity - 1)];
+    }
 }
@@ -1,19 +1,33 @@
 #ifndef FCFSQUEUE_H
 #define FCFSQUEUE_H
 
-#include "LinkedList.h"
+#include <cstddef>
 
+// Growable ring buffer of patient IDs. Capacity is a power of two so the
+// wrap around is a mask, and nothing is allocated until the first enqueue.
 class FCFSQueue {
 private:
-    LinkedList<int> patients; // stores patient IDs
+    int* patients; // stores patient IDs
+    int capacity;
+    int head; // index of the first patient
+    int count;
+
+    void grow();
+
+    FCFSQueue(const FCFSQueue& other); // not copyable
+    FCFSQueue& operator=(const FCFSQueue& other);
 
 public:
+    FCFSQueue();
+    ~FCFSQueue();
     void enqueue(int patientId);
     int dequeue();
     bool isEmpty() const;
+    int length() const;
     int getFirst() const;
     int getLast() const;
     int removeBack();
+    void copyTo(int* out) const; // length() ids, first in line first
 };
 
 #endif
@@ -0,0 +1,199 @@
+#include "HospitalNetwork.h"
+#include <climits>
+#include <thread>
+#include <vector>
+
+HospitalNetwork::HospitalNetwork(DES** hospitals, int numHospitals)
+{
+    this->hospitals = hospitals;
+    this->numHospitals = numHospitals;
+    numThreads = 0;
+    windows = 0;
+    generation = 0;
+    windowEnd = 0;
+    running = 0;
+    stopping = false;
+    next = 0;
+    for (int h = 0; h < numHospitals; h++) {
+        hospitals[h]->hospitalId = h;
+    }
+}
+
+bool HospitalNetwork::setTransfer(int from, int to, int delay, int threshold)
+{
+    if (from < 0 || from >= numHospitals || to < 0 || to >= numHospitals || from == to
+        || delay < 1 || threshold < 0) {
+        return false;
+    }
+    hospitals[from]->transferDestination = to;
+    hospitals[from]->transferDelay = delay;
+    hospitals[from]->transferThreshold = threshold;
+    return true;
+}
+
+void HospitalNetwork::setThreads(int n)
+{
+    numThreads = n;
+}
+
+long long HospitalNetwork::getWindows() const
+{
+    return windows;
+}
+
+// shortest transfer delay, INT_MAX when nobody transfers
+int HospitalNetwork::lookahead() const
+{
+    int shortest = INT_MAX;
+    for (int h = 0; h < numHospitals; h++) {
+        if (hospitals[h]->transferThreshold >= 0 && hospitals[h]->transferDelay < shortest) {
+            shortest = hospitals[h]->transferDelay;
+        }
+    }
+    return shortest;
+}
+
+// time of the earliest event or transfer of any hospital, false if none
+bool HospitalNetwork::earliest(int& time)
+{
+    bool found = false;
+    for (int h = 0; h < numHospitals; h++) {
+        if (hospitals[h]->hasEvents()) {
+            int t = hospitals[h]->nextTime();
+            if (!found || t < time) {
+                time = t;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+void HospitalNetwork::deliver(int h)
+{
+    std::vector<Transfer>& sent = hospitals[h]->outbox;
+    for (size_t i = 0; i < sent.size(); i++) {
+        hospitals[sent[i].destination]->receive(sent[i]);
+    }
+    sent.clear();
+}
+
+void HospitalNetwork::runWindow()
+{
+    while (true) {
+        int h = next.fetch_add(1);
+        if (h >= numHospitals) {
+            return;
+        }
+        hospitals[h]->runUntil(windowEnd);
+    }
+}
+
+void HospitalNetwork::work(HospitalNetwork* network)
+{
+    int seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(network->lock);
+            while (network->generation == seen) {
+                network->started.wait(guard);
+            }
+            seen = network->generation;
+            if (network->stopping) {
+                return;
+            }
+        }
+        network->runWindow();
+        std::lock_guard<std::mutex> guard(network->lock);
+        network->running--;
+        if (network->running == 0) {
+            network->finished.notify_one();
+        }
+    }
+}
+
+void HospitalNetwork::run()
+{
+    int threads = numThreads;
+    if (threads == 0) {
+        threads = (int)std::thread::hardware_concurrency();
+    }
+    if (threads > numHospitals) {
+        threads = numHospitals;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    int window = lookahead();
+    windows = 0;
+    generation = 0;
+    stopping = false;
+
+    // the calling thread is one of the workers.
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.push_back(std::thread(work, this));
+    }
+    int start;
+    while (earliest(start) && start < INT_MAX) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            long long end = (long long)start + window;
+            windowEnd = end > INT_MAX ? INT_MAX : (int)end;
+            next = 0;
+            running = threads;
+            generation++;
+        }
+        started.notify_all();
+        runWindow();
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            running--;
+            while (running > 0) {
+                finished.wait(guard);
+            }
+        }
+        // everything sent in the window arrives at windowEnd or later.
+        for (int h = 0; h < numHospitals; h++) {
+            deliver(h);
+        }
+        windows++;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        generation++;
+    }
+    started.notify_all();
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+    for (int h = 0; h < numHospitals; h++) {
+        hospitals[h]->run();
+    }
+}
+
+void HospitalNetwork::runSequential()
+{
+    while (true) {
+        int first = -1;
+        int firstTime = 0;
+        for (int h = 0; h < numHospitals; h++) {
+            if (hospitals[h]->hasEvents()) {
+                int t = hospitals[h]->nextTime();
+                if (first == -1 || t < firstTime) {
+                    first = h;
+                    firstTime = t;
+                }
+            }
+        }
+        if (first == -1) {
+            break;
+        }
+        hospitals[first]->step();
+        deliver(first);
+    }
+    for (int h = 0; h < numHospitals; h++) {
+        hospitals[h]->run();
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef HOSPITALNETWORK_H
+#define HOSPITALNETWORK_H
+
+#include "DES.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// A regional network of hospitals, one DES each, that send patients on to
+// each other. A patient leaving triage whose tier already has threshold
+// patients waiting for a doctor is transferred: they leave (a
+// PatientLeaveHospital without a doctor in the trace) and after the
+// transport delay join the doctor queue of the destination as a new
+// patient there (a DoctorQueueEntrance with no triage before it).
+//
+// run() spreads the hospitals over threads and keeps them in step with a
+// windowed barrier. No transfer takes less than the shortest delay L, so
+// when W is the earliest pending time nothing can reach any hospital
+// before W + L, and every hospital may run up to there on its own. At the
+// barrier the transfers sent in the window are delivered and the next
+// window starts at the new earliest time, so idle stretches are skipped.
+// The result, traces included, is the same as runSequential(), which
+// processes one event at a time in global time order, for any number of
+// threads.
+//
+// The hospitals run on different threads, so each needs its own trace
+// stream (or summary only mode); the default std::cout is shared.
+class HospitalNetwork {
+private:
+    DES** hospitals;
+    int numHospitals;
+    int numThreads;
+    long long windows;
+
+    // the current window, handed from run() to the workers
+    std::mutex lock;
+    std::condition_variable started;
+    std::condition_variable finished;
+    int generation; // windows started, workers wait for it to change
+    int windowEnd;
+    int running; // threads still inside the window
+    bool stopping;
+    std::atomic<int> next; // next hospital of the window to take
+
+    int lookahead() const;
+    bool earliest(int& time);
+    void deliver(int h);
+    void runWindow();
+    static void work(HospitalNetwork* network);
+
+    HospitalNetwork(const HospitalNetwork& other); // not copyable
+    HospitalNetwork& operator=(const HospitalNetwork& other);
+
+public:
+    // Hospital i is hospitals[i]; the caller keeps ownership.
+    HospitalNetwork(DES** hospitals, int numHospitals);
+    // Patients leaving triage at from with at least threshold patients of
+    // their tier in the doctor queue go to to, arriving delay later.
+    // false for a bad index, from == to, delay < 1 or threshold < 0.
+    bool setTransfer(int from, int to, int delay, int threshold);
+    void setThreads(int n); // 0 means one per hardware thread (the default)
+    // Runs every hospital to the end, each finishing its trace as run()
+    // does.
+    void run();
+    void runSequential();
+    long long getWindows() const; // barriers the last run() went through
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "IntrusiveFCFSQueue.h"
+
+IntrusiveFCFSQueue::IntrusiveFCFSQueue(PatientTable& patients) : list(patients)
+{
+}
+
+void IntrusiveFCFSQueue::enqueue(int patientId)
+{
+    list.pushBack(patientId);
+}
+
+int IntrusiveFCFSQueue::dequeue()
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    return list.popFront();
+}
+
+bool IntrusiveFCFSQueue::isEmpty() const
+{
+    return list.isEmpty();
+}
+
+int IntrusiveFCFSQueue::length() const
+{
+    return list.length();
+}
+
+int IntrusiveFCFSQueue::getFirst() const
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    return list.front();
+}
+
+int IntrusiveFCFSQueue::getLast() const
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    return list.back();
+}
+
+int IntrusiveFCFSQueue::removeBack()
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    return list.popBack();
+}
+
+void IntrusiveFCFSQueue::remove(int patientId)
+{
+    list.remove(patientId);
+}
+
+void IntrusiveFCFSQueue::copyTo(int* out) const
+{
+    int i = 0;
+    for (int id = list.front(); id != -1; id = list.next(id)) {
+        out[i] = id;
+        i++;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef INTRUSIVEFCFSQUEUE_H
+#define INTRUSIVEFCFSQUEUE_H
+
+#include "IntrusiveList.h"
+#include "PatientTable.h"
+
+// FCFSQueue threaded through the patients' own records: the queue is the
+// queueHook links of the PatientRecords in a PatientTable, so it never
+// allocates, and a patient is taken out of the middle in O(1). Patients
+// have to stay in the table while they are queued, and a patient is in at
+// most one such queue at a time.
+class IntrusiveFCFSQueue {
+private:
+    IntrusiveList<PatientTable, PatientRecord, &PatientRecord::queueHook> list;
+
+    IntrusiveFCFSQueue(const IntrusiveFCFSQueue& other); // not copyable
+    IntrusiveFCFSQueue& operator=(const IntrusiveFCFSQueue& other);
+
+public:
+    explicit IntrusiveFCFSQueue(PatientTable& patients);
+    void enqueue(int patientId);
+    int dequeue(); // like FCFSQueue, an empty queue answers 0
+    bool isEmpty() const;
+    int length() const;
+    int getFirst() const;
+    int getLast() const;
+    int removeBack();
+    void remove(int patientId); // the patient must be in this queue
+    void copyTo(int* out) const; // length() ids, first in line first
+};
+
+#endif
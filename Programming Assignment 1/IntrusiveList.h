@@ -0,0 +1,104 @@
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+// The links of a record in an IntrusiveList, as ids in the record's table,
+// -1 at either end.
+struct ListHook
+{
+    int prev;
+    int next;
+};
+
+// Doubly linked list of records that live in a table owned by the caller,
+// such as the PatientTable. Every record carries a ListHook, so adding and
+// removing only rewrites links: nothing is allocated or copied, and a
+// record is removed from anywhere in O(1). A record can be in one list per
+// hook at a time.
+//
+// The links are ids, not pointers, so the table may move its records when
+// it grows. Table is anything with Record& operator[](int id); a plain
+// array works too, by passing the pointer to it as the table.
+template <typename Table, typename Record, ListHook Record::*hook>
+class IntrusiveList {
+private:
+    Table* table;
+    int head;
+    int tail;
+    int count;
+
+    ListHook& links(int id) const { return (*table)[id].*hook; }
+
+    IntrusiveList(const IntrusiveList& other); // not copyable
+    IntrusiveList& operator=(const IntrusiveList& other);
+
+public:
+    explicit IntrusiveList(Table& table) : table(&table), head(-1), tail(-1), count(0) {}
+
+    void pushFront(int id) { insertBefore(id, head); }
+    void pushBack(int id) { insertBefore(id, -1); }
+    // links id in front of before, -1 is the end
+    void insertBefore(int id, int before)
+    {
+        int prev = (before != -1) ? links(before).prev : tail;
+        ListHook& h = links(id);
+        h.prev = prev;
+        h.next = before;
+        if (prev != -1) {
+            links(prev).next = id;
+        }
+        else {
+            head = id;
+        }
+        if (before != -1) {
+            links(before).prev = id;
+        }
+        else {
+            tail = id;
+        }
+        count++;
+    }
+    // id must be in this list
+    void remove(int id)
+    {
+        ListHook& h = links(id);
+        if (h.prev != -1) {
+            links(h.prev).next = h.next;
+        }
+        else {
+            head = h.next;
+        }
+        if (h.next != -1) {
+            links(h.next).prev = h.prev;
+        }
+        else {
+            tail = h.prev;
+        }
+        count--;
+    }
+    // -1 when empty
+    int popFront()
+    {
+        int id = head;
+        if (id != -1) {
+            remove(id);
+        }
+        return id;
+    }
+    int popBack()
+    {
+        int id = tail;
+        if (id != -1) {
+            remove(id);
+        }
+        return id;
+    }
+
+    int front() const { return head; } // -1 when empty
+    int back() const { return tail; }
+    int next(int id) const { return links(id).next; } // -1 after the back
+    int prev(int id) const { return links(id).prev; }
+    bool isEmpty() const { return head == -1; }
+    int length() const { return count; }
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "IntrusiveSortedList.h"
+#include <cstddef>
+
+static const int FREE = -2;
+
+IntrusiveSortedList::IntrusiveSortedList() : records(NULL), capacity(0), freeRecords(-1), list(records)
+{
+}
+
+IntrusiveSortedList::~IntrusiveSortedList()
+{
+    delete[] records;
+}
+
+void IntrusiveSortedList::grow()
+{
+    // the links are indices, so the records move as they are.
+    int newCapacity = (capacity == 0) ? 16 : capacity * 2;
+    EventRecord* bigger = new EventRecord[newCapacity];
+    for (int i = 0; i < capacity; i++) {
+        bigger[i] = records[i];
+    }
+    delete[] records;
+    records = bigger;
+    // the table is full, so the new records are the only free ones.
+    for (int i = newCapacity - 1; i >= capacity; i--) {
+        records[i].hook.prev = FREE;
+        records[i].hook.next = freeRecords;
+        freeRecords = i;
+    }
+    capacity = newCapacity;
+}
+
+void IntrusiveSortedList::release(int id)
+{
+    list.remove(id);
+    records[id].hook.prev = FREE;
+    records[id].hook.next = freeRecords;
+    freeRecords = id;
+}
+
+void IntrusiveSortedList::add(const Event& data)
+{
+    addCancellable(data);
+}
+
+int IntrusiveSortedList::addCancellable(const Event& data)
+{
+    if (freeRecords == -1) {
+        grow();
+    }
+    int id = freeRecords;
+    freeRecords = records[id].hook.next;
+    records[id].key = EventKey(data);
+
+    // the walk is SortedLinkedList's: equal events go after the old ones.
+    const EventKey key(data);
+    const EventRecord* r = records;
+    int before = list.front();
+    while (before != -1 && !(key < r[before].key)) {
+        before = r[before].hook.next;
+    }
+    list.insertBefore(id, before);
+    return id;
+}
+
+bool IntrusiveSortedList::cancel(int handle)
+{
+    if (handle < 0 || handle >= capacity || records[handle].hook.prev == FREE) {
+        return false;
+    }
+    release(handle);
+    return true;
+}
+
+Event IntrusiveSortedList::removeSmallest()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    int id = list.front();
+    Event smallest = records[id].key.event();
+    release(id);
+    return smallest;
+}
+
+bool IntrusiveSortedList::isEmpty() const
+{
+    return list.isEmpty();
+}
+
+int IntrusiveSortedList::length() const
+{
+    return list.length();
+}
+
+Event IntrusiveSortedList::getFirst() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    return records[list.front()].key.event();
+}
+
+Event IntrusiveSortedList::getLast() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    return records[list.back()].key.event();
+}
+
+void IntrusiveSortedList::copyTo(Event* out) const
+{
+    int i = 0;
+    for (int id = list.front(); id != -1; id = list.next(id)) {
+        out[i] = records[id].key.event();
+        i++;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef INTRUSIVESORTEDLIST_H
+#define INTRUSIVESORTEDLIST_H
+
+#include "EventSet.h"
+#include "EventKey.h"
+#include "IntrusiveList.h"
+
+// An event set record: the event and its links in the sorted list.
+struct EventRecord
+{
+    EventKey key;
+    ListHook hook; // prev is -2 while the record is free
+};
+
+// SortedLinkedList with the list threaded through a table of EventRecords
+// by IntrusiveList. A record's index is its cancel handle, so cancel is
+// O(1); freed records are chained through their hooks and reused, and the
+// table only grows by doubling.
+class IntrusiveSortedList : public EventSet {
+private:
+    EventRecord* records;
+    int capacity;
+    int freeRecords; // first free record, -1 when the table is full
+    IntrusiveList<EventRecord*, EventRecord, &EventRecord::hook> list;
+
+    void grow();
+    void release(int id);
+
+    IntrusiveSortedList(const IntrusiveSortedList& other); // not copyable
+    IntrusiveSortedList& operator=(const IntrusiveSortedList& other);
+
+public:
+    IntrusiveSortedList();
+    ~IntrusiveSortedList();
+    void add(const Event& data);
+    int addCancellable(const Event& data);
+    bool cancel(int handle);
+    Event removeSmallest();
+    bool isEmpty() const;
+    int length() const;
+    Event getFirst() const;
+    Event getLast() const;
+    void copyTo(Event* out) const;
+};
+
+#endif
@@ -1,67 +1,274 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <utility>
+#include "SlabPool.h"
 
-class MonotonicStack;
-class SortedLinkedList;
-
-// Template Node class
+// Template Node class, data is built in place from the arguments.
 template <typename T>
 class Node {
 public:
     T data;
     Node* next;
     Node* prev;
-    Node(const T& d) : data(d), next(0), prev(0) {}
+    template <typename... Args>
+    explicit Node(Args&&... args) : data(std::forward<Args>(args)...), next(0), prev(0) {}
 };
 
-// Template LinkedList class
+// Default node allocator of LinkedList, nodes are recycled through a
+// SlabPool so steady state add/remove does not touch the heap.
 template <typename T>
+class NodePool {
+private:
+    SlabPool<Node<T> > blocks;
+
+public:
+    template <typename... Args>
+    Node<T>* create(Args&&... args)
+    {
+        return new (blocks.allocate()) Node<T>(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node<T>* node)
+    {
+        node->~Node<T>();
+        blocks.deallocate(node);
+    }
+
+    void reserve(int n) { blocks.reserve(n); }
+    // other's nodes may now be destroyed here, other is left empty.
+    void absorb(NodePool& other) { blocks.absorb(other.blocks); }
+};
+
+// Plain new/delete per node, the allocator LinkedList used to hard code.
+template <typename T>
+class HeapNodeAllocator {
+public:
+    template <typename... Args>
+    Node<T>* create(Args&&... args)
+    {
+        return new Node<T>(std::forward<Args>(args)...);
+    }
+    void destroy(Node<T>* node) { delete node; }
+    void reserve(int) {}
+    void absorb(HeapNodeAllocator&) {}
+};
+
+template <typename T, typename Alloc>
+class LinkedList;
+
+// Bidirectional iterator of LinkedList, Value is T or const T. end() has
+// no node, stepping back from it goes to the tail of the list.
+template <typename T, typename Value>
+class ListIterator {
+private:
+    Node<T>* node;
+    Node<T>* const* tail; // the list's tail, for --end()
+
+    ListIterator(Node<T>* node, Node<T>* const* tail) : node(node), tail(tail) {}
+
+    template <typename, typename>
+    friend class ListIterator;
+    template <typename, typename>
+    friend class LinkedList;
+
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    ListIterator() : node(0), tail(0) {}
+    // an iterator converts to a const_iterator
+    ListIterator(const ListIterator<T, T>& other) : node(other.node), tail(other.tail) {}
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    ListIterator& operator++()
+    {
+        node = node->next;
+        return *this;
+    }
+    ListIterator operator++(int)
+    {
+        ListIterator old = *this;
+        node = node->next;
+        return old;
+    }
+    ListIterator& operator--()
+    {
+        node = (node != NULL) ? node->prev : *tail;
+        return *this;
+    }
+    ListIterator operator--(int)
+    {
+        ListIterator old = *this;
+        --*this;
+        return old;
+    }
+
+    template <typename V>
+    bool operator==(const ListIterator<T, V>& other) const { return node == other.node; }
+    template <typename V>
+    bool operator!=(const ListIterator<T, V>& other) const { return node != other.node; }
+};
+
+// Template LinkedList class
+template <typename T, typename Alloc = NodePool<T> >
 class LinkedList {
 private:
     Node<T>* head;
     Node<T>* tail;
+    Alloc allocator; // creates and destroys every Node of this list
+
+    void link(Node<T>* node, Node<T>* before); // puts node in front of before, NULL is the end
+    void takeAll(LinkedList& other); // other's allocator, once its nodes are ours
 
 public:
+    typedef ListIterator<T, T> iterator;
+    typedef ListIterator<T, const T> const_iterator;
+
     LinkedList() : head(0), tail(0) {}
+    LinkedList(const LinkedList& other);
+    // moving takes the nodes and their allocator, no element is touched.
+    LinkedList(LinkedList&& other);
     ~LinkedList();
+    LinkedList& operator=(const LinkedList& other);
+    LinkedList& operator=(LinkedList&& other);
+
     void addFront(const T& data);
     void addBack(const T& data);
+    void addFront(T&& data) { emplaceFront(std::move(data)); }
+    void addBack(T&& data) { emplaceBack(std::move(data)); }
+    template <typename... Args>
+    void emplaceFront(Args&&... args);
+    template <typename... Args>
+    void emplaceBack(Args&&... args);
+    // builds the element in front of pos and returns it
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    // the removes move the element out of its node
     T removeFront();
     T removeBack();
+    void clear();
     bool isEmpty() const;
     int length() const;
     T getFront() const;
     T getBack() const;
-    
-    friend class SortedLinkedList;
-    friend class MonotonicStack;
-    friend class FCFSQueue;
-    friend class TieredFCFSQueue;
-    friend class priorityQueue;
-    
-    // Overloading the << operator to enable easy printing of MonotonicStack objects
-    // This allows us to use `std::cout << s;` instead of writing a separate print() function.
-    friend std::ostream& operator<<(std::ostream& os, const MonotonicStack& event);
+    void reserve(int n) { allocator.reserve(n); }
+
+    iterator begin() { return iterator(head, &tail); }
+    iterator end() { return iterator(0, &tail); }
+    const_iterator begin() const { return const_iterator(head, &tail); }
+    const_iterator end() const { return const_iterator(0, &tail); }
+
+    // Moves every node of other in front of pos in O(1), other is left
+    // empty. Its allocator comes along, since the nodes were made there.
+    void splice(const_iterator pos, LinkedList& other);
+    // Merges the sorted other into this sorted list by relinking nodes,
+    // O(length() + other.length()) and stable: of equal elements (by
+    // operator<) the ones of this list stay first. other is left empty.
+    void merge(LinkedList& other);
 };
 
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::link(Node<T>* node, Node<T>* before)
+{
+    Node<T>* after = before;
+    Node<T>* prev = (after != NULL) ? after->prev : tail;
+    node->prev = prev;
+    node->next = after;
+    if (prev != NULL) {
+        prev->next = node;
+    }
+    else {
+        head = node;
+    }
+    if (after != NULL) {
+        after->prev = node;
+    }
+    else {
+        tail = node;
+    }
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::takeAll(LinkedList& other)
+{
+    other.head = NULL;
+    other.tail = NULL;
+    allocator.absorb(other.allocator);
+}
+
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList& other) : head(0), tail(0)
+{
+    for (Node<T>* curr = other.head; curr != NULL; curr = curr->next) {
+        addBack(curr->data);
+    }
+}
+
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(LinkedList&& other) : head(other.head), tail(other.tail)
+{
+    takeAll(other);
+}
+
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>& LinkedList<T, Alloc>::operator=(const LinkedList& other)
+{
+    if (this != &other) {
+        // the old nodes go back to the allocator and are reused.
+        clear();
+        for (Node<T>* curr = other.head; curr != NULL; curr = curr->next) {
+            addBack(curr->data);
+        }
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>& LinkedList<T, Alloc>::operator=(LinkedList&& other)
+{
+    if (this != &other) {
+        clear();
+        head = other.head;
+        tail = other.tail;
+        takeAll(other);
+    }
+    return *this;
+}
+
 // Destructor
-template <typename T>
-LinkedList<T>::~LinkedList()
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::~LinkedList()
 {
     // YOUR CODE GOES HERE
-    while(!(isEmpty())){
-        removeFront();
+    clear();
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::clear()
+{
+    while (head != NULL) {
+        Node<T>* next = head->next;
+        allocator.destroy(head);
+        head = next;
     }
+    tail = NULL;
 }
 
 // Add element to front
-template <typename T>
-void LinkedList<T>::addFront(const T& data)
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::addFront(const T& data)
 {
     // YOUR CODE GOES HERE
-    Node<T>* bc = new Node<T>(data);
+    Node<T>* bc = allocator.create(data);
     bc->next =head;
     
     if(head !=  NULL){
@@ -74,12 +281,12 @@ void LinkedList<T>::addFront(const T& data)
 }
 
 // Add element to back
-template <typename T>
-void LinkedList<T>::addBack(const T& data)
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::addBack(const T& data)
 {
     // YOUR CODE GOES HERE
     // nearly same as above.
-    Node<T>* bc = new Node<T>(data);
+    Node<T>* bc = allocator.create(data);
     bc->prev =tail;
     
     if(tail != NULL){
@@ -91,9 +298,90 @@ void LinkedList<T>::addBack(const T& data)
     }
 }
 
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplaceFront(Args&&... args)
+{
+    link(allocator.create(std::forward<Args>(args)...), head);
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplaceBack(Args&&... args)
+{
+    link(allocator.create(std::forward<Args>(args)...), NULL);
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::emplace(const_iterator pos, Args&&... args)
+{
+    Node<T>* node = allocator.create(std::forward<Args>(args)...);
+    link(node, pos.node);
+    return iterator(node, &tail);
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::splice(const_iterator pos, LinkedList& other)
+{
+    if (&other == this || other.head == NULL) {
+        return;
+    }
+    Node<T>* after = pos.node;
+    Node<T>* prev = (after != NULL) ? after->prev : tail;
+    other.head->prev = prev;
+    other.tail->next = after;
+    if (prev != NULL) {
+        prev->next = other.head;
+    }
+    else {
+        head = other.head;
+    }
+    if (after != NULL) {
+        after->prev = other.tail;
+    }
+    else {
+        tail = other.tail;
+    }
+    takeAll(other);
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::merge(LinkedList& other)
+{
+    if (&other == this) {
+        return;
+    }
+    Node<T>* curr = head;
+    Node<T>* incoming = other.head;
+    // incoming nodes go in front of the first node of this list that is
+    // greater, the rest is hooked on at the end in one piece.
+    while (incoming != NULL && curr != NULL) {
+        if (incoming->data < curr->data) {
+            Node<T>* next = incoming->next;
+            link(incoming, curr);
+            incoming = next;
+        }
+        else {
+            curr = curr->next;
+        }
+    }
+    if (incoming != NULL) {
+        incoming->prev = tail;
+        if (tail != NULL) {
+            tail->next = incoming;
+        }
+        else {
+            head = incoming;
+        }
+        tail = other.tail;
+    }
+    takeAll(other);
+}
+
 // Remove element from front
-template <typename T>
-T LinkedList<T>::removeFront()
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::removeFront()
 {
     // YOUR CODE GOES HERE
     if(isEmpty()){
@@ -101,7 +389,7 @@ T LinkedList<T>::removeFront()
     }
     
     Node<T>*tmp = head;
-    T data = tmp->data;
+    T data(std::move(tmp->data));
     head = head->next;
 
     if(head != NULL){
@@ -110,13 +398,13 @@ T LinkedList<T>::removeFront()
     else{
         tail = NULL;
     }
-    delete tmp;
+    allocator.destroy(tmp);
     return data;
 }
 
 // Remove element from back
-template <typename T>
-T LinkedList<T>::removeBack()
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::removeBack()
 {
     // YOUR CODE GOES HERE
     if(isEmpty()){
@@ -125,7 +413,7 @@ T LinkedList<T>::removeBack()
     
     
     Node<T>*tmp = tail;
-    T data = tmp->data;
+    T data(std::move(tmp->data));
     tail = tail->prev;
 
     if(tail != NULL){
@@ -134,21 +422,21 @@ T LinkedList<T>::removeBack()
     else{
         head = NULL;
     }
-    delete tmp;
+    allocator.destroy(tmp);
     return data;
 }
 
 // Check if list is empty
-template <typename T>
-bool LinkedList<T>::isEmpty() const
+template <typename T, typename Alloc>
+bool LinkedList<T, Alloc>::isEmpty() const
 {
     // YOUR CODE GOES HERE
     return (head == NULL);
 }
 
 // Get length of list
-template <typename T>
-int LinkedList<T>::length() const
+template <typename T, typename Alloc>
+int LinkedList<T, Alloc>::length() const
 {
     // YOUR CODE GOES HERE
     int i = 0;
@@ -160,8 +448,8 @@ int LinkedList<T>::length() const
     return i;
 }
 
-template <typename T>
-T LinkedList<T>::getFront() const
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::getFront() const
 {
     // YOUR CODE GOES HERE
     if(!(isEmpty())){
@@ -170,8 +458,8 @@ T LinkedList<T>::getFront() const
     return T();
 }
 
-template <typename T>
-T LinkedList<T>::getBack() const
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::getBack() const
 {
     // YOUR CODE GOES HERE
     if(!(isEmpty())){
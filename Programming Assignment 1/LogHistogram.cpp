@@ -0,0 +1,181 @@
+#include "LogHistogram.h"
+#include "Checkpoint.h"
+
+// index of the highest set bit, x must not be 0
+static int highestBit(unsigned int x)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    int n = -1;
+    while (x != 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+LogHistogram::LogHistogram()
+{
+    clear();
+}
+
+void LogHistogram::clear()
+{
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        counts[i] = 0;
+    }
+    total = 0;
+    sum = 0;
+    smallest = -1;
+    largest = -1;
+}
+
+int LogHistogram::bucketOf(int value)
+{
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    // the top SUB_BITS + 1 bits pick the bucket, the first of them is
+    // always set so it is dropped.
+    int shift = highestBit((unsigned int)value) - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+int LogHistogram::bucketHigh(int bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    long long low = (long long)(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return (int)(low + (1LL << shift) - 1);
+}
+
+void LogHistogram::record(int value)
+{
+    if (value < 0) {
+        value = 0;
+    }
+    counts[bucketOf(value)]++;
+    if (total == 0 || value < smallest) {
+        smallest = value;
+    }
+    if (value > largest) {
+        largest = value;
+    }
+    total++;
+    sum += value;
+}
+
+void LogHistogram::merge(const LogHistogram& other)
+{
+    if (other.total == 0) {
+        return;
+    }
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        counts[i] += other.counts[i];
+    }
+    if (total == 0 || other.smallest < smallest) {
+        smallest = other.smallest;
+    }
+    if (other.largest > largest) {
+        largest = other.largest;
+    }
+    total += other.total;
+    sum += other.sum;
+}
+
+long long LogHistogram::count() const
+{
+    return total;
+}
+
+long long LogHistogram::totalValue() const
+{
+    return sum;
+}
+
+double LogHistogram::mean() const
+{
+    if (total == 0) {
+        return -1;
+    }
+    return (double)sum / total;
+}
+
+int LogHistogram::min() const
+{
+    return smallest;
+}
+
+int LogHistogram::max() const
+{
+    return largest;
+}
+
+int LogHistogram::percentile(double q) const
+{
+    if (total == 0) {
+        return -1;
+    }
+    long long rank = (long long)(q * total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    long long seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            int high = bucketHigh(i);
+            return high < largest ? high : largest;
+        }
+    }
+    return largest;
+}
+
+void LogHistogram::save(CheckpointWriter& out) const
+{
+    int used = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        used += counts[i] != 0;
+    }
+    out.putCount(used);
+    int previous = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        if (counts[i] != 0) {
+            out.putCount(i - previous);
+            out.putInt(counts[i]);
+            previous = i;
+        }
+    }
+    out.putInt(total);
+    out.putInt(sum);
+    out.putInt(smallest);
+    out.putInt(largest);
+}
+
+bool LogHistogram::load(CheckpointReader& in)
+{
+    clear();
+    int used = in.getCount(NUM_BUCKETS);
+    int bucket = 0;
+    for (int k = 0; k < used && !in.failed(); k++) {
+        bucket += in.getCount(NUM_BUCKETS - 1);
+        if (bucket >= NUM_BUCKETS) {
+            in.fail();
+            break;
+        }
+        counts[bucket] = in.getInt();
+    }
+    total = in.getInt();
+    sum = in.getInt();
+    smallest = in.getInt32();
+    largest = in.getInt32();
+    if (in.failed()) {
+        clear();
+        return false;
+    }
+    return true;
+}
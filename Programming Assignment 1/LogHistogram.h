@@ -0,0 +1,43 @@
+#ifndef LOGHISTOGRAM_H
+#define LOGHISTOGRAM_H
+
+class CheckpointWriter;
+class CheckpointReader;
+
+// Histogram of non negative ints in a fixed amount of memory. Values below
+// 16 get a bucket each; above that every power of two is split into 16
+// buckets, so a bucket is at most 1/16 of its values wide. Negative values
+// are recorded as 0.
+class LogHistogram {
+private:
+    static const int SUB_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int NUM_BUCKETS = (31 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    long long counts[NUM_BUCKETS];
+    long long total;
+    long long sum;
+    int smallest;
+    int largest;
+
+    static int bucketOf(int value);
+    static int bucketHigh(int bucket); // largest value of the bucket
+
+public:
+    LogHistogram();
+    void clear();
+    void record(int value);
+    void merge(const LogHistogram& other);
+    long long count() const;
+    long long totalValue() const; // sum of the recorded values
+    double mean() const; // -1 if empty
+    int min() const;     // -1 if empty
+    int max() const;     // -1 if empty
+    // Smallest bucket bound with at least fraction q of the values at or
+    // below it, never above max(). -1 if empty.
+    int percentile(double q) const;
+    void save(CheckpointWriter& out) const; // only the buckets in use
+    bool load(CheckpointReader& in);
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "MappedArrivalFile.h"
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DES_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char BINARY_MAGIC[8] = {'D', 'E', 'S', 'A', 'R', 'R', 'V', '1'};
+static const long long RELEASE_STEP = 64ll << 20; // hand back every 64 MB
+
+MappedArrivalFile::MappedArrivalFile(const char* path)
+{
+    data = NULL;
+    size = 0;
+    position = 0;
+    released = 0;
+    binary = false;
+    mapped = false;
+    owned = NULL;
+    lineNumber = 0;
+    badLine = 0;
+
+#ifdef DES_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd != -1) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* p = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, (size_t)info.st_size, MADV_SEQUENTIAL);
+                data = (const char*)p;
+                size = (long long)info.st_size;
+                mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+    if (!mapped) {
+        std::ifstream file(path, std::ios::binary);
+        if (file) {
+            file.seekg(0, std::ios::end);
+            size = (long long)file.tellg();
+            file.seekg(0, std::ios::beg);
+            owned = new char[size > 0 ? size : 1];
+            file.read(owned, size);
+            data = owned;
+        }
+    }
+    if (data != NULL && size >= 8 && std::memcmp(data, BINARY_MAGIC, 8) == 0) {
+        binary = true;
+        position = 8;
+    }
+}
+
+MappedArrivalFile::~MappedArrivalFile()
+{
+#ifdef DES_HAVE_MMAP
+    if (mapped) {
+        munmap((void*)data, (size_t)size);
+    }
+#endif
+    delete[] owned;
+}
+
+bool MappedArrivalFile::isOpen() const
+{
+    return data != NULL;
+}
+
+int MappedArrivalFile::errorLine() const
+{
+    return badLine;
+}
+
+void MappedArrivalFile::releaseConsumed()
+{
+#ifdef DES_HAVE_MMAP
+    if (!mapped || position - released < RELEASE_STEP) {
+        return;
+    }
+    long long page = sysconf(_SC_PAGESIZE);
+    long long upTo = (position / page) * page;
+    if (upTo > released) {
+        madvise((void*)(data + released), (size_t)(upTo - released), MADV_DONTNEED);
+        released = upTo;
+    }
+#endif
+}
+
+static unsigned int readLittleEndian(const char* p)
+{
+    const unsigned char* b = (const unsigned char*)p;
+    return (unsigned int)b[0] | ((unsigned int)b[1] << 8) | ((unsigned int)b[2] << 16) | ((unsigned int)b[3] << 24);
+}
+
+// an optionally signed decimal in [p, end), skipping spaces around it
+static bool parseInt(const char*& p, const char* end, int& v)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    // INT_MIN has no positive counterpart
+    long long limit = negative ? 2147483648ll : 2147483647ll;
+    long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        if (value > limit) {
+            return false;
+        }
+        p++;
+    }
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    v = (int)(negative ? -value : value);
+    return true;
+}
+
+bool MappedArrivalFile::nextCsv(int& arrivalTime, int& urgencyLevel)
+{
+    while (position < size && badLine == 0) {
+        const char* line = data + position;
+        const char* newline = (const char*)std::memchr(line, '\n', (size_t)(size - position));
+        const char* end = (newline != NULL) ? newline : data + size;
+        position = (end - data) + 1;
+        lineNumber++;
+
+        const char* p = line;
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        if (p == end || *p == '#') {
+            continue;
+        }
+        int a, u;
+        if (parseInt(p, end, a) && p < end && *p == ',' && parseInt(++p, end, u) && p == end) {
+            arrivalTime = a;
+            urgencyLevel = u;
+            return true;
+        }
+        // a header is only allowed as the first line.
+        if (lineNumber != 1) {
+            badLine = lineNumber;
+        }
+    }
+    return false;
+}
+
+bool MappedArrivalFile::next(int& arrivalTime, int& urgencyLevel)
+{
+    if (data == NULL) {
+        return false;
+    }
+    releaseConsumed();
+    if (!binary) {
+        return nextCsv(arrivalTime, urgencyLevel);
+    }
+    if (size - position < 8) {
+        return false;
+    }
+    arrivalTime = (int)readLittleEndian(data + position);
+    urgencyLevel = (int)readLittleEndian(data + position + 4);
+    position += 8;
+    return true;
+}
+
+void MappedArrivalFile::writeBinaryHeader(std::ostream& os)
+{
+    os.write(BINARY_MAGIC, 8);
+}
+
+void MappedArrivalFile::writeBinaryRecord(std::ostream& os, int arrivalTime, int urgencyLevel)
+{
+    char bytes[8];
+    unsigned int values[2] = {(unsigned int)arrivalTime, (unsigned int)urgencyLevel};
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < 4; i++) {
+            bytes[4 * k + i] = (char)(values[k] >> (8 * i));
+        }
+    }
+    os.write(bytes, 8);
+}
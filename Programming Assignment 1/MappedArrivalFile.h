@@ -0,0 +1,45 @@
+#ifndef MAPPEDARRIVALFILE_H
+#define MAPPEDARRIVALFILE_H
+
+#include "ArrivalSource.h"
+#include <iostream>
+
+// Arrivals read straight from a memory mapped file, sorted by arrival time.
+// Two formats are recognized by their first bytes:
+//   binary  "DESARRV1", then arrivalTime and urgencyLevel of every patient
+//           as little endian 32 bit integers
+//   CSV     "arrivalTime,urgencyLevel" lines, with an optional header line,
+//           blank lines and '#' comments, as in PatientDataset
+// Pages already read are given back to the system as the reader moves on,
+// so a file much larger than memory can be streamed. Where mmap is not
+// available the file is read into memory instead.
+class MappedArrivalFile : public ArrivalSource {
+private:
+    const char* data;
+    long long size;
+    long long position;
+    long long released; // bytes before this were handed back
+    bool binary;
+    bool mapped;
+    char* owned; // the copy when the file could not be mapped
+    int lineNumber;
+    int badLine;
+
+    void releaseConsumed();
+    bool nextCsv(int& arrivalTime, int& urgencyLevel);
+
+    MappedArrivalFile(const MappedArrivalFile& other); // not copyable
+    MappedArrivalFile& operator=(const MappedArrivalFile& other);
+
+public:
+    MappedArrivalFile(const char* path);
+    ~MappedArrivalFile();
+    bool isOpen() const;
+    int errorLine() const; // first malformed CSV line, 0 if none so far
+    bool next(int& arrivalTime, int& urgencyLevel);
+
+    static void writeBinaryHeader(std::ostream& os);
+    static void writeBinaryRecord(std::ostream& os, int arrivalTime, int urgencyLevel);
+};
+
+#endif
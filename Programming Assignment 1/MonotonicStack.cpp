@@ -1,56 +1,143 @@
 #include "MonotonicStack.h"
+#include <cstddef>
+
+// like LinkedList<int>, an empty stack answers 0.
 
 MonotonicStack::MonotonicStack()
 {
     // YOUR CODE GOES HERE
-    /* handled by linkedlist*/
+    items = NULL;
+    count = 0;
+    capacity = 0;
 }
 MonotonicStack::~MonotonicStack()
 {
     // YOUR CODE GOES HERE
-    /* handled by linkedlist*/
+    delete[] items;
+}
+
+void MonotonicStack::reserve(int n)
+{
+    if (n <= capacity) {
+        return;
+    }
+    // grows by half: doctor stacks live as long as the run, so the slack
+    // is kept small.
+    int newCapacity = (capacity == 0) ? 16 : capacity + capacity / 2;
+    if (newCapacity < n) {
+        newCapacity = n;
+    }
+    int* bigger = new int[newCapacity];
+    for (int i = 0; i < count; i++) {
+        bigger[i] = items[i];
+    }
+    delete[] items;
+    items = bigger;
+    capacity = newCapacity;
+}
+
+int MonotonicStack::upperBound(int patientId) const
+{
+    int low = 0;
+    int high = count;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (patientId < items[middle]) {
+            high = middle;
+        }
+        else {
+            low = middle + 1;
+        }
+    }
+    return low;
 }
 
 void MonotonicStack::push(int patientId)
 {
     // YOUR CODE GOES HERE
-    while(!(data.isEmpty()) && patientId < data.getBack()){
-        data.removeBack();
+    // DES pushes increasing ids, so the search is only for the rest.
+    if (count > 0 && patientId < items[count - 1]) {
+        count = upperBound(patientId);
+    }
+    if (count == capacity) {
+        reserve(count + 1);
     }
-    data.addBack(patientId);
+    items[count] = patientId;
+    count++;
+}
+
+void MonotonicStack::pushRange(const int* ids, int n)
+{
+    if (n <= 0) {
+        return;
+    }
+    // An id survives the ones after it if none of them is smaller, so
+    // the survivors come from a scan from the back that keeps the running
+    // minimum. They are parked at the end of the free space, the stack is
+    // cut once at the smallest id, and they move down behind it.
+    reserve(count + n);
+    int smallest = ids[n - 1];
+    int first = count + n;
+    for (int i = n - 1; i >= 0; i--) {
+        if (ids[i] <= smallest) {
+            smallest = ids[i];
+            first--;
+            items[first] = ids[i];
+        }
+    }
+    int cut = upperBound(smallest);
+    int survivors = count + n - first;
+    for (int i = 0; i < survivors; i++) {
+        items[cut + i] = items[first + i];
+    }
+    count = cut + survivors;
 }
 
 int MonotonicStack::pop()
 {
     // YOUR CODE GOES HERE
-    return data.removeBack();
+    if (count == 0) {
+        return 0;
+    }
+    count--;
+    return items[count];
 }
 
 int MonotonicStack::top() const
 {
     // YOUR CODE GOES HERE
-    return data.getBack();
+    return count == 0 ? 0 : items[count - 1];
 }
 
 bool MonotonicStack::isEmpty() const
 {
     // YOUR CODE GOES HERE
-    return data.isEmpty();
+    return count == 0;
+}
+
+int MonotonicStack::length() const
+{
+    return count;
 }
 
+void MonotonicStack::copyTo(int* out) const
+{
+    // same order as operator<<, top to bottom.
+    for (int i = count - 1; i >= 0; i--) {
+        *out++ = items[i];
+    }
+}
 
 std::ostream& operator<<(std::ostream& os, const MonotonicStack& ms)
 {
     // YOUR CODE GOES HERE
-    Node<int>*curr = ms.data.tail;
+    // top to bottom.
     os <<"{";
-    while(curr != NULL){
-        os<<curr->data;
-        if(curr->prev != NULL){
+    for (int i = ms.count - 1; i >= 0; i--) {
+        if (i != ms.count - 1) {
             os <<", ";
-            
         }
-        curr = curr->prev;
+        os << ms.items[i];
     }
     os << "}";
     return os;
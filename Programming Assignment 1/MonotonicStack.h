@@ -1,19 +1,34 @@
 #ifndef MONOTONICSTACK_H
 #define MONOTONICSTACK_H
 
-#include "LinkedList.h"
+#include <iostream>
 
+// Patient ids, ascending from the bottom: a push first drops every id
+// above the new one. The ids sit in one array, sorted by construction, so
+// the cut point is found by binary search and dropped by moving the end.
 class MonotonicStack {
 private:
-    LinkedList<int> data; // stores patient IDs
+    int* items; // bottom first
+    int count;
+    int capacity;
+
+    void reserve(int n);
+    int upperBound(int patientId) const; // first index above patientId
+
+    MonotonicStack(const MonotonicStack& other); // not copyable
+    MonotonicStack& operator=(const MonotonicStack& other);
 
 public:
     MonotonicStack();
     ~MonotonicStack();
     void push(int patientId);
+    // the same as pushing ids[0] .. ids[n - 1] one by one, with one cut
+    void pushRange(const int* ids, int n);
     int pop();
     int top() const;
     bool isEmpty() const;
+    int length() const;
+    void copyTo(int* out) const; // length() ids, top of the stack first
     
     // Overloading the << operator to enable easy printing of MonotonicStack objects
     // This allows us to use `std::cout << s;` instead of writing a separate print() function.
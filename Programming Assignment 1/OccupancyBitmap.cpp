@@ -0,0 +1,175 @@
+#include "OccupancyBitmap.h"
+
+static const int WORD_BITS = 64;
+
+// index of the lowest set bit, x must not be 0
+static int lowestBit(unsigned long long x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while ((x & 1ull) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// index of the highest set bit, x must not be 0
+static int highestBit(unsigned long long x)
+{
+#if defined(__GNUC__)
+    return WORD_BITS - 1 - __builtin_clzll(x);
+#else
+    int n = -1;
+    while (x != 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+OccupancyBitmap::OccupancyBitmap(int n)
+{
+    size = n > 0 ? n : 0;
+    numLeaves = (size + WORD_BITS - 1) / WORD_BITS;
+    numSummary = (numLeaves + WORD_BITS - 1) / WORD_BITS;
+    if (numSummary == 0) {
+        numSummary = 1;
+    }
+    leaves = new unsigned long long[numLeaves > 0 ? numLeaves : 1];
+    summary = new unsigned long long[numSummary];
+    for (int i = 0; i < numLeaves; i++) {
+        leaves[i] = 0;
+    }
+    for (int i = 0; i < numSummary; i++) {
+        summary[i] = 0;
+    }
+    count = 0;
+}
+
+void OccupancyBitmap::resize(int n)
+{
+    if (n <= size) {
+        return;
+    }
+    int newLeaves = (n + WORD_BITS - 1) / WORD_BITS;
+    int newSummary = (newLeaves + WORD_BITS - 1) / WORD_BITS;
+    unsigned long long* biggerLeaves = new unsigned long long[newLeaves];
+    unsigned long long* biggerSummary = new unsigned long long[newSummary];
+    for (int i = 0; i < newLeaves; i++) {
+        biggerLeaves[i] = i < numLeaves ? leaves[i] : 0;
+    }
+    for (int i = 0; i < newSummary; i++) {
+        biggerSummary[i] = i < numSummary ? summary[i] : 0;
+    }
+    delete[] leaves;
+    delete[] summary;
+    leaves = biggerLeaves;
+    summary = biggerSummary;
+    numLeaves = newLeaves;
+    numSummary = newSummary;
+    size = n;
+}
+
+OccupancyBitmap::~OccupancyBitmap()
+{
+    delete[] leaves;
+    delete[] summary;
+}
+
+void OccupancyBitmap::set(int i)
+{
+    if (i < 0 || i >= size || test(i)) {
+        return;
+    }
+    int leaf = i / WORD_BITS;
+    leaves[leaf] |= 1ull << (i % WORD_BITS);
+    summary[leaf / WORD_BITS] |= 1ull << (leaf % WORD_BITS);
+    count++;
+}
+
+void OccupancyBitmap::clear(int i)
+{
+    if (i < 0 || i >= size || !test(i)) {
+        return;
+    }
+    int leaf = i / WORD_BITS;
+    leaves[leaf] &= ~(1ull << (i % WORD_BITS));
+    if (leaves[leaf] == 0) {
+        summary[leaf / WORD_BITS] &= ~(1ull << (leaf % WORD_BITS));
+    }
+    count--;
+}
+
+bool OccupancyBitmap::test(int i) const
+{
+    if (i < 0 || i >= size) {
+        return false;
+    }
+    return (leaves[i / WORD_BITS] >> (i % WORD_BITS)) & 1ull;
+}
+
+bool OccupancyBitmap::isEmpty() const
+{
+    return count == 0;
+}
+
+int OccupancyBitmap::capacity() const
+{
+    return size;
+}
+
+int OccupancyBitmap::findFirst() const
+{
+    // one summary word up to 4096 slots, so this loop runs once there.
+    for (int s = 0; s < numSummary; s++) {
+        if (summary[s] != 0) {
+            int leaf = s * WORD_BITS + lowestBit(summary[s]);
+            return leaf * WORD_BITS + lowestBit(leaves[leaf]);
+        }
+    }
+    return -1;
+}
+
+int OccupancyBitmap::findLast() const
+{
+    for (int s = numSummary - 1; s >= 0; s--) {
+        if (summary[s] != 0) {
+            int leaf = s * WORD_BITS + highestBit(summary[s]);
+            return leaf * WORD_BITS + highestBit(leaves[leaf]);
+        }
+    }
+    return -1;
+}
+
+int OccupancyBitmap::findNext(int from) const
+{
+    if (from < 0) {
+        from = 0;
+    }
+    if (from >= size) {
+        return -1;
+    }
+    // rest of the leaf word holding from, then the rest of its summary word.
+    int leaf = from / WORD_BITS;
+    unsigned long long bits = leaves[leaf] & (~0ull << (from % WORD_BITS));
+    if (bits != 0) {
+        return leaf * WORD_BITS + lowestBit(bits);
+    }
+    leaf++;
+    for (int s = leaf / WORD_BITS; s < numSummary && leaf < numLeaves; s++) {
+        unsigned long long words = summary[s];
+        if (s == leaf / WORD_BITS) {
+            words &= ~0ull << (leaf % WORD_BITS);
+        }
+        if (words != 0) {
+            int next = s * WORD_BITS + lowestBit(words);
+            return next * WORD_BITS + lowestBit(leaves[next]);
+        }
+    }
+    return -1;
+}
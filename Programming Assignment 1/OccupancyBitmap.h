@@ -0,0 +1,34 @@
+#ifndef OCCUPANCYBITMAP_H
+#define OCCUPANCYBITMAP_H
+
+// Two level bitmap over n slots. Bit i of the leaf level says slot i is
+// occupied, bit j of the summary level says leaf word j is not zero. With
+// 64 bit words one summary word covers 4096 slots, so the first or last
+// occupied slot is found with two count-zeros instructions.
+class OccupancyBitmap {
+private:
+    unsigned long long* leaves;
+    unsigned long long* summary;
+    int numLeaves;
+    int numSummary;
+    int size;
+    int count; // number of occupied slots
+
+    OccupancyBitmap(const OccupancyBitmap& other); // not copyable
+    OccupancyBitmap& operator=(const OccupancyBitmap& other);
+
+public:
+    OccupancyBitmap(int n);
+    ~OccupancyBitmap();
+    void set(int i);
+    void clear(int i);
+    bool test(int i) const;
+    bool isEmpty() const;
+    int capacity() const;
+    void resize(int n); // grows to n slots, the new ones empty; never shrinks
+    int findFirst() const; // -1 if nothing is set
+    int findLast() const;  // -1 if nothing is set
+    int findNext(int from) const; // first set slot >= from, -1 if none
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "ParameterSweep.h"
+#include <thread>
+#include <vector>
+
+static int valueCount(const SweepRange& r)
+{
+    if (r.step <= 0 || r.to < r.from) {
+        return 1;
+    }
+    return (r.to - r.from) / r.step + 1;
+}
+
+static int valueAt(const SweepRange& r, int i)
+{
+    return r.from + i * (r.step > 0 ? r.step : 0);
+}
+
+ParameterSweep::ParameterSweep(const PatientDataset& data, const SweepGrid& grid)
+{
+    this->data = &data;
+    numThreads = 0;
+    const SweepRange* ranges[6] = {&grid.triages, &grid.doctors, &grid.tiers,
+                                   &grid.triageDuration, &grid.doctorVisitDuration, &grid.boringDuration};
+    int counts[6];
+    numPoints = 1;
+    for (int k = 0; k < 6; k++) {
+        counts[k] = valueCount(*ranges[k]);
+        numPoints *= counts[k];
+    }
+
+    // the last parameter changes fastest.
+    points = new SweepPoint[numPoints];
+    maxTiers = 0;
+    for (int i = 0; i < numPoints; i++) {
+        int values[6];
+        int rest = i;
+        for (int k = 5; k >= 0; k--) {
+            values[k] = valueAt(*ranges[k], rest % counts[k]);
+            rest /= counts[k];
+        }
+        SweepPoint& p = points[i];
+        p.numTriages = values[0];
+        p.numDoctors = values[1];
+        p.numTiers = values[2] > 0 ? values[2] : 1;
+        p.triageDuration = values[3];
+        p.doctorVisitDuration = values[4];
+        p.boringDuration = values[5];
+        p.stats.eventsProcessed = 0;
+        p.stats.patientsTreated = 0;
+        p.stats.patientsBored = 0;
+        p.stats.finishTime = -1;
+        p.stats.peakPatients = 0;
+        p.stats.boredInTriage = 0;
+        p.stats.boredAtDoctor = 0;
+        p.stats.maxTriageQueue = 0;
+        p.stats.maxDoctorQueue = 0;
+        p.stats.triageUtilization = 0;
+        p.stats.doctorUtilization = 0;
+        p.stats.patientsTransferred = 0;
+        p.stats.patientsReceived = 0;
+        p.meanWait = new double[p.numTiers];
+        for (int t = 0; t < p.numTiers; t++) {
+            p.meanWait[t] = -1;
+        }
+        if (p.numTiers > maxTiers) {
+            maxTiers = p.numTiers;
+        }
+    }
+}
+
+ParameterSweep::~ParameterSweep()
+{
+    for (int i = 0; i < numPoints; i++) {
+        delete[] points[i].meanWait;
+    }
+    delete[] points;
+}
+
+int ParameterSweep::pointCount() const
+{
+    return numPoints;
+}
+
+const SweepPoint& ParameterSweep::point(int i) const
+{
+    return points[i];
+}
+
+void ParameterSweep::setThreads(int n)
+{
+    numThreads = n > 0 ? n : 0;
+}
+
+void ParameterSweep::runPoint(int i)
+{
+    SweepPoint& p = points[i];
+    int n = data->size();
+    const int* urgencies = data->urgencyLevels();
+    int* clamped = NULL;
+    if (data->maxUrgency() >= p.numTiers) {
+        clamped = new int[n > 0 ? n : 1];
+        for (int j = 0; j < n; j++) {
+            clamped[j] = urgencies[j] < p.numTiers ? urgencies[j] : p.numTiers - 1;
+        }
+        urgencies = clamped;
+    }
+
+    DES sim(p.numTriages, p.numDoctors, p.numTiers, p.triageDuration, p.doctorVisitDuration,
+            p.boringDuration, n, urgencies, data->arrivalTimes());
+    sim.setSummaryOnly(true);
+    p.stats = sim.run();
+    for (int t = 0; t < p.numTiers; t++) {
+        p.meanWait[t] = sim.getMeanWait(t);
+    }
+    delete[] clamped;
+}
+
+void ParameterSweep::work(ParameterSweep* sweep, std::atomic<int>* next)
+{
+    while (true) {
+        int i = next->fetch_add(1);
+        if (i >= sweep->numPoints) {
+            return;
+        }
+        sweep->runPoint(i);
+    }
+}
+
+void ParameterSweep::run()
+{
+    int threads = numThreads;
+    if (threads == 0) {
+        threads = (int)std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+    if (threads > numPoints) {
+        threads = numPoints;
+    }
+
+    std::atomic<int> next(0);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.push_back(std::thread(work, this, &next));
+    }
+    work(this, &next);
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+}
+
+void ParameterSweep::writeCsv(std::ostream& os) const
+{
+    os << "triages,doctors,tiers,triage_duration,doctor_duration,boring_duration,completed,bored,finish_time";
+    for (int t = 0; t < maxTiers; t++) {
+        os << ",mean_wait_tier_" << t;
+    }
+    os << '\n';
+    for (int i = 0; i < numPoints; i++) {
+        const SweepPoint& p = points[i];
+        os << p.numTriages << ',' << p.numDoctors << ',' << p.numTiers << ',' << p.triageDuration << ','
+           << p.doctorVisitDuration << ',' << p.boringDuration << ',' << p.stats.patientsTreated << ','
+           << p.stats.patientsBored << ',' << p.stats.finishTime;
+        for (int t = 0; t < maxTiers; t++) {
+            os << ',';
+            if (t < p.numTiers && p.meanWait[t] >= 0) {
+                os << p.meanWait[t];
+            }
+        }
+        os << '\n';
+    }
+    os.flush();
+}
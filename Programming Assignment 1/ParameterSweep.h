@@ -0,0 +1,57 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "DES.h"
+#include "PatientDataset.h"
+#include <atomic>
+#include <iostream>
+
+// from, from + step, ... up to to. A step <= 0 means only from.
+struct SweepRange
+{
+    int from, to, step;
+};
+
+struct SweepGrid
+{
+    SweepRange triages, doctors, tiers;
+    SweepRange triageDuration, doctorVisitDuration, boringDuration;
+};
+
+struct SweepPoint
+{
+    int numTriages, numDoctors, numTiers;
+    int triageDuration, doctorVisitDuration, boringDuration;
+    DESStatistics stats;
+    double* meanWait; // per tier, see DES::getMeanWait
+};
+
+// Runs DES on every point of a grid against one shared dataset, points in
+// parallel. Patients whose urgency is beyond a point's tiers are put in its
+// last tier instead of being dropped, so every point sees every patient.
+class ParameterSweep {
+private:
+    const PatientDataset* data;
+    SweepPoint* points;
+    int numPoints;
+    int maxTiers; // most tiers of any point, for the CSV columns
+    int numThreads;
+
+    void runPoint(int i);
+    static void work(ParameterSweep* sweep, std::atomic<int>* next);
+
+    ParameterSweep(const ParameterSweep& other); // not copyable
+    ParameterSweep& operator=(const ParameterSweep& other);
+
+public:
+    ParameterSweep(const PatientDataset& data, const SweepGrid& grid);
+    ~ParameterSweep();
+    int pointCount() const;
+    const SweepPoint& point(int i) const;
+    void setThreads(int n); // 0 means one per hardware thread (the default)
+    void run();
+    // one row per point in grid order, empty cells for missing tiers
+    void writeCsv(std::ostream& os) const;
+};
+
+#endif
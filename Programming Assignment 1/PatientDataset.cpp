@@ -0,0 +1,123 @@
+#include "PatientDataset.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+PatientDataset::PatientDataset()
+{
+    arrivals = NULL;
+    urgencies = NULL;
+    count = 0;
+    capacity = 0;
+    highestUrgency = -1;
+}
+
+PatientDataset::~PatientDataset()
+{
+    delete[] arrivals;
+    delete[] urgencies;
+}
+
+void PatientDataset::add(int arrivalTime, int urgencyLevel)
+{
+    if (count == capacity) {
+        int newCapacity = (capacity == 0) ? 64 : capacity * 2;
+        int* biggerArrivals = new int[newCapacity];
+        int* biggerUrgencies = new int[newCapacity];
+        for (int i = 0; i < count; i++) {
+            biggerArrivals[i] = arrivals[i];
+            biggerUrgencies[i] = urgencies[i];
+        }
+        delete[] arrivals;
+        delete[] urgencies;
+        arrivals = biggerArrivals;
+        urgencies = biggerUrgencies;
+        capacity = newCapacity;
+    }
+    arrivals[count] = arrivalTime;
+    urgencies[count] = urgencyLevel;
+    count++;
+    if (urgencyLevel > highestUrgency) {
+        highestUrgency = urgencyLevel;
+    }
+}
+
+// reads "a,b" with optional spaces, false unless that is the whole line,
+// a fits in an int and b is an urgency in [0, INT_MAX]
+static bool parsePair(const char* line, int& a, int& b)
+{
+    char* end;
+    errno = 0;
+    long first = std::strtol(line, &end, 10);
+    if (end == line || errno == ERANGE || first < INT_MIN || first > INT_MAX) {
+        return false;
+    }
+    while (*end == ' ' || *end == '\t') {
+        end++;
+    }
+    if (*end != ',') {
+        return false;
+    }
+    const char* rest = end + 1;
+    long second = std::strtol(rest, &end, 10);
+    if (end == rest || errno == ERANGE || second < 0 || second > INT_MAX) {
+        return false;
+    }
+    while (*end == ' ' || *end == '\t' || *end == '\r') {
+        end++;
+    }
+    if (*end != '\0') {
+        return false;
+    }
+    a = (int)first;
+    b = (int)second;
+    return true;
+}
+
+int PatientDataset::loadCsv(std::istream& in)
+{
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        const char* p = line.c_str();
+        while (*p == ' ' || *p == '\t') {
+            p++;
+        }
+        if (*p == '\0' || *p == '\r' || *p == '#') {
+            continue;
+        }
+        int arrival, urgency;
+        if (!parsePair(p, arrival, urgency)) {
+            // a header is only allowed as the first line.
+            if (lineNumber == 1) {
+                continue;
+            }
+            return lineNumber;
+        }
+        add(arrival, urgency);
+    }
+    return 0;
+}
+
+int PatientDataset::size() const
+{
+    return count;
+}
+
+const int* PatientDataset::arrivalTimes() const
+{
+    return arrivals;
+}
+
+const int* PatientDataset::urgencyLevels() const
+{
+    return urgencies;
+}
+
+int PatientDataset::maxUrgency() const
+{
+    return highestUrgency;
+}
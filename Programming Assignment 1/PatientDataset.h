@@ -0,0 +1,33 @@
+#ifndef PATIENTDATASET_H
+#define PATIENTDATASET_H
+
+#include <iostream>
+
+// Arrival times and urgency levels of a patient population, loaded once
+// and shared by every simulation that uses it.
+class PatientDataset {
+private:
+    int* arrivals;
+    int* urgencies;
+    int count;
+    int capacity;
+    int highestUrgency;
+
+    PatientDataset(const PatientDataset& other); // not copyable
+    PatientDataset& operator=(const PatientDataset& other);
+
+public:
+    PatientDataset();
+    ~PatientDataset();
+    void add(int arrivalTime, int urgencyLevel);
+    // Appends "arrivalTime,urgencyLevel" lines. Blank lines, lines starting
+    // with '#' and a header line are skipped. Returns the number of the
+    // first malformed line, 0 if there was none.
+    int loadCsv(std::istream& in);
+    int size() const;
+    const int* arrivalTimes() const;
+    const int* urgencyLevels() const;
+    int maxUrgency() const; // -1 if empty
+};
+
+#endif
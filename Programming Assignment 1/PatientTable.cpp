@@ -0,0 +1,142 @@
+#include "PatientTable.h"
+#include "Checkpoint.h"
+#include <cstddef>
+
+PatientTable::PatientTable()
+{
+    slots = NULL;
+    capacity = 0;
+    first = 0;
+    end = 0;
+    count = 0;
+}
+
+PatientTable::~PatientTable()
+{
+    delete[] slots;
+}
+
+void PatientTable::reserve(int n)
+{
+    while (capacity < n) {
+        grow();
+    }
+}
+
+void PatientTable::grow()
+{
+    int newCapacity = (capacity == 0) ? 64 : capacity * 2;
+    PatientRecord* bigger = new PatientRecord[newCapacity];
+    for (int id = first; id < end; id++) {
+        bigger[id & (newCapacity - 1)] = slots[id & (capacity - 1)];
+    }
+    delete[] slots;
+    slots = bigger;
+    capacity = newCapacity;
+}
+
+int PatientTable::add(int urgency)
+{
+    if (end - first == capacity) {
+        grow();
+    }
+    int id = end;
+    PatientRecord& r = slots[id & (capacity - 1)];
+    r.urgency = urgency;
+    r.arrivalTime = -1;
+    r.triageTimer = -1;
+    r.doctorTimer = -1;
+    r.doctorQueueSince = -1;
+    r.queueHook.prev = -1;
+    r.queueHook.next = -1;
+    r.active = true;
+    end++;
+    count++;
+    return id;
+}
+
+bool PatientTable::contains(int id) const
+{
+    return id >= first && id < end && slots[id & (capacity - 1)].active;
+}
+
+PatientRecord& PatientTable::operator[](int id)
+{
+    return slots[id & (capacity - 1)];
+}
+
+const PatientRecord& PatientTable::operator[](int id) const
+{
+    return slots[id & (capacity - 1)];
+}
+
+void PatientTable::remove(int id)
+{
+    if (!contains(id)) {
+        return;
+    }
+    slots[id & (capacity - 1)].active = false;
+    count--;
+    // the window starts at the oldest patient still inside.
+    while (first < end && !slots[first & (capacity - 1)].active) {
+        first++;
+    }
+}
+
+int PatientTable::size() const
+{
+    return count;
+}
+
+int PatientTable::nextId() const
+{
+    return end;
+}
+
+void PatientTable::save(CheckpointWriter& out) const
+{
+    out.putInt(first);
+    out.putCount(end - first);
+    for (int id = first; id < end; id++) {
+        const PatientRecord& r = slots[id & (capacity - 1)];
+        out.putBool(r.active);
+        if (r.active) {
+            out.putInt(r.urgency);
+            out.putInt(r.arrivalTime);
+            out.putInt(r.doctorQueueSince);
+        }
+    }
+}
+
+bool PatientTable::load(CheckpointReader& in)
+{
+    int newFirst = in.getInt32();
+    int window = in.getLength();
+    if (in.failed() || newFirst < 0 || (long long)newFirst + window > 2147483647LL) {
+        in.fail();
+        return false;
+    }
+    first = newFirst;
+    end = newFirst;
+    count = 0;
+    reserve(window);
+    for (int i = 0; i < window; i++) {
+        PatientRecord& r = slots[end & (capacity - 1)];
+        r.active = in.getBool();
+        r.urgency = 0;
+        r.arrivalTime = -1;
+        r.doctorQueueSince = -1;
+        r.triageTimer = -1;
+        r.doctorTimer = -1;
+        r.queueHook.prev = -1;
+        r.queueHook.next = -1;
+        if (r.active) {
+            r.urgency = in.getInt32();
+            r.arrivalTime = in.getInt32();
+            r.doctorQueueSince = in.getInt32();
+            count++;
+        }
+        end++;
+    }
+    return !in.failed();
+}
@@ -0,0 +1,55 @@
+#ifndef PATIENTTABLE_H
+#define PATIENTTABLE_H
+
+#include "IntrusiveList.h"
+
+class CheckpointWriter;
+class CheckpointReader;
+
+// What DES keeps per patient while the patient is in the hospital.
+struct PatientRecord
+{
+    int urgency;
+    int arrivalTime; // when the patient entered the triage queue
+    int triageTimer; // handle of the pending boredom event, -1 if none
+    int doctorTimer;
+    int doctorQueueSince; // when the patient entered the doctor queue
+    ListHook queueHook; // links of an IntrusiveFCFSQueue holding the patient
+    bool active;
+};
+
+// Patients by id, for ids that come in increasing order and leave roughly
+// in the same order. Only the window from the oldest patient still inside
+// to the newest one is stored, in a ring indexed by id, so memory follows
+// the number of patients in the hospital, not the number that ever came.
+class PatientTable {
+private:
+    PatientRecord* slots;
+    int capacity; // power of 2
+    int first;    // oldest id that may still be active
+    int end;      // one past the newest id
+    int count;    // active patients
+
+    void grow();
+
+    PatientTable(const PatientTable& other); // not copyable
+    PatientTable& operator=(const PatientTable& other);
+
+public:
+    PatientTable();
+    ~PatientTable();
+    void reserve(int n); // room for a window of n ids
+    int add(int urgency); // the next id, as an active patient
+    bool contains(int id) const; // false once the patient was removed
+    PatientRecord& operator[](int id); // id must be contained
+    const PatientRecord& operator[](int id) const;
+    void remove(int id);
+    int size() const; // active patients
+    int nextId() const;
+    // The window and the patients inside it, without their timer handles
+    // and queue links; load leaves those at -1. load returns false on malformed input.
+    void save(CheckpointWriter& out) const;
+    bool load(CheckpointReader& in);
+};
+
+#endif
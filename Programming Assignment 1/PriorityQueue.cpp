@@ -1,31 +1,80 @@
 #include "PriorityQueue.h"
 
-void PriorityQueue::enqueue(const Event& e)
+PriorityQueue::PriorityQueue(EventSetEngine engine)
+{
+    events = EventSet::create(engine);
+#ifdef DES_PROFILE
+    profile.enqueues = 0;
+    profile.dequeues = 0;
+    profile.cancels = 0;
+    profile.peeks = 0;
+    profile.ticks = 0;
+#endif
+}
+
+PriorityQueue::~PriorityQueue()
+{
+    delete events;
+}
+
+int PriorityQueue::enqueue(const Event& e)
 {
     // YOUR CODE GOES HERE
-    events.add(e);
+    DES_PROFILE_COUNT(profile.enqueues);
+    DES_PROFILE_TIME(profile.ticks);
+    return events->addCancellable(e);
+}
+
+bool PriorityQueue::cancel(int handle)
+{
+    DES_PROFILE_COUNT(profile.cancels);
+    DES_PROFILE_TIME(profile.ticks);
+    return events->cancel(handle);
 }
 
 Event PriorityQueue::dequeue()
 {
     // YOUR CODE GOES HERE
-    return events.removeSmallest();
+    DES_PROFILE_COUNT(profile.dequeues);
+    DES_PROFILE_TIME(profile.ticks);
+    return events->removeSmallest();
 }
 
 bool PriorityQueue::isEmpty() const
 {
     // YOUR CODE GOES HERE
-    return events.isEmpty();
+    return events->isEmpty();
+}
+
+int PriorityQueue::length() const
+{
+    return events->length();
 }
 
 Event PriorityQueue::getFirst() const
 {
     // YOUR CODE GOES HERE
-    return events.list.getFront();
+    DES_PROFILE_COUNT(profile.peeks);
+    DES_PROFILE_TIME(profile.ticks);
+    return events->getFirst();
 }
 
 Event PriorityQueue::getLast() const
 {
     // YOUR CODE GOES HERE
-    return events.list.getBack();
+    DES_PROFILE_COUNT(profile.peeks);
+    DES_PROFILE_TIME(profile.ticks);
+    return events->getLast();
+}
+
+void PriorityQueue::copyTo(Event* out) const
+{
+    events->copyTo(out);
+}
+
+#ifdef DES_PROFILE
+const QueueProfile& PriorityQueue::getProfile() const
+{
+    return profile;
 }
+#endif
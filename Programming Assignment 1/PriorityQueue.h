@@ -1,19 +1,34 @@
 #ifndef PRIORITYQUEUE_H
 #define PRIORITYQUEUE_H
 
-#include "SortedLinkedList.h"
+#include "EventSet.h"
+#include "DESProfiler.h"
 
 class PriorityQueue {
 private:
-    SortedLinkedList events;
+    EventSet* events; // engine picked at construction, 4-ary heap by default
+#ifdef DES_PROFILE
+    mutable QueueProfile profile;
+#endif
+
+    PriorityQueue(const PriorityQueue& other); // not copyable
+    PriorityQueue& operator=(const PriorityQueue& other);
 
 public:
-    void enqueue(const Event& e);
+    PriorityQueue(EventSetEngine engine = HeapEngine);
+    ~PriorityQueue();
+    int enqueue(const Event& e); // handle for cancel, -1 if the engine has none
+    bool cancel(int handle);
     Event dequeue();
     bool isEmpty() const;
+    int length() const;
     
     Event getFirst() const;
     Event getLast() const;
+    void copyTo(Event* out) const; // length() events, in no particular order
+#ifdef DES_PROFILE
+    const QueueProfile& getProfile() const;
+#endif
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,226 @@
+#include "RadixHeap.h"
+
+// index of the highest set bit + 1, x must not be 0
+static int bitLength(unsigned int x)
+{
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(x);
+#else
+    int n = 0;
+    while (x != 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// index of the lowest set bit, x must not be 0
+static int lowestBit(unsigned int x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    while ((x & 1u) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+RadixHeap::RadixHeap()
+{
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        buckets[i].items = NULL;
+        buckets[i].count = 0;
+        buckets[i].capacity = 0;
+    }
+    occupied = 0;
+    last = 0;
+    count = 0;
+    cachedValid = false;
+}
+
+RadixHeap::~RadixHeap()
+{
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        delete[] buckets[i].items;
+    }
+}
+
+unsigned int RadixHeap::keyOf(const Event& e)
+{
+    // flipping the sign bit keeps the order of negative times too.
+    return (unsigned int)e.time ^ 0x80000000u;
+}
+
+int RadixHeap::bucketOf(unsigned int key) const
+{
+    unsigned int diff = key ^ last;
+    if (diff == 0) {
+        return 0;
+    }
+    return bitLength(diff);
+}
+
+void RadixHeap::push(int bucket, const Event& e)
+{
+    if (bucket == 0) {
+        current.add(e);
+        return;
+    }
+    RadixBucket& b = buckets[bucket];
+    if (b.count == b.capacity) {
+        int newCapacity = (b.capacity == 0) ? 8 : b.capacity * 2;
+        Event* bigger = new Event[newCapacity];
+        for (int i = 0; i < b.count; i++) {
+            bigger[i] = b.items[i];
+        }
+        delete[] b.items;
+        b.items = bigger;
+        b.capacity = newCapacity;
+    }
+    b.items[b.count] = e;
+    b.count++;
+    occupied |= 1u << (bucket - 1);
+}
+
+void RadixHeap::rebase(unsigned int newLast)
+{
+    // slow path for an event earlier than the last removed one, DES never
+    // does this. Take everything out and bucket it again around newLast.
+    Event* all = new Event[count];
+    int n = 0;
+    while (!current.isEmpty()) {
+        all[n] = current.removeSmallest();
+        n++;
+    }
+    for (int i = 1; i < NUM_BUCKETS; i++) {
+        for (int j = 0; j < buckets[i].count; j++) {
+            all[n] = buckets[i].items[j];
+            n++;
+        }
+        buckets[i].count = 0;
+    }
+    occupied = 0;
+    last = newLast;
+    for (int i = 0; i < n; i++) {
+        push(bucketOf(keyOf(all[i])), all[i]);
+    }
+    delete[] all;
+}
+
+void RadixHeap::refill()
+{
+    // current is empty: the smallest time sits in the lowest occupied bucket.
+    // It becomes the new last and that bucket is spread over lower buckets.
+    int i = lowestBit(occupied) + 1;
+    RadixBucket& b = buckets[i];
+    unsigned int smallest = keyOf(b.items[0]);
+    for (int j = 1; j < b.count; j++) {
+        unsigned int key = keyOf(b.items[j]);
+        if (key < smallest) {
+            smallest = key;
+        }
+    }
+    last = smallest;
+    for (int j = 0; j < b.count; j++) {
+        push(bucketOf(keyOf(b.items[j])), b.items[j]);
+    }
+    b.count = 0;
+    occupied &= ~(1u << (i - 1));
+}
+
+void RadixHeap::add(const Event& data)
+{
+    unsigned int key = keyOf(data);
+    if (count == 0) {
+        last = key;
+    }
+    else if (key < last) {
+        rebase(key);
+    }
+    push(bucketOf(key), data);
+    count++;
+
+    if (cachedValid && data < cachedFirst) {
+        cachedFirst = data;
+    }
+}
+
+Event RadixHeap::removeSmallest()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    if (current.isEmpty()) {
+        refill();
+    }
+    count--;
+    cachedValid = false;
+    return current.removeSmallest();
+}
+
+bool RadixHeap::isEmpty() const
+{
+    return count == 0;
+}
+
+int RadixHeap::length() const
+{
+    return count;
+}
+
+Event RadixHeap::getFirst() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    if (!current.isEmpty()) {
+        return current.getFirst();
+    }
+    if (!cachedValid) {
+        const RadixBucket& b = buckets[lowestBit(occupied) + 1];
+        cachedFirst = b.items[0];
+        for (int j = 1; j < b.count; j++) {
+            if (b.items[j] < cachedFirst) {
+                cachedFirst = b.items[j];
+            }
+        }
+        cachedValid = true;
+    }
+    return cachedFirst;
+}
+
+Event RadixHeap::getLast() const
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    if (occupied == 0) {
+        return current.getLast();
+    }
+    // higher buckets hold strictly later times.
+    const RadixBucket& b = buckets[bitLength(occupied)];
+    Event largest = b.items[0];
+    for (int j = 1; j < b.count; j++) {
+        if (largest < b.items[j]) {
+            largest = b.items[j];
+        }
+    }
+    return largest;
+}
+
+void RadixHeap::copyTo(Event* out) const
+{
+    current.copyTo(out);
+    int i = current.length();
+    for (int b = 1; b < NUM_BUCKETS; b++) {
+        for (int j = 0; j < buckets[b].count; j++) {
+            out[i] = buckets[b].items[j];
+            i++;
+        }
+    }
+}
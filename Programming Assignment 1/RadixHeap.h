@@ -0,0 +1,56 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include "EventHeap.h"
+
+// Radix heap keyed on Event::time. It relies on the event set being
+// monotone: nothing is added before the last removed event, which holds in
+// DES::run because every new event is at or after the current time.
+// Bucket i > 0 holds events whose time differs from the last removed time
+// first at bit i-1, so an event only ever moves to lower buckets and each
+// one is touched at most 33 times. Bucket 0 holds the events at exactly the
+// last removed time; it is a small EventHeap so ties are still broken by
+// patientId, type and resourceId as in Event::operator<.
+class RadixHeap : public EventSet {
+private:
+    static const int NUM_BUCKETS = 33;
+
+    struct RadixBucket {
+        Event* items;
+        int count;
+        int capacity;
+    };
+
+    EventHeap current; // bucket 0
+    RadixBucket buckets[NUM_BUCKETS]; // buckets[0] is unused, see current
+    unsigned int occupied; // bit i set if buckets[i] is not empty
+    unsigned int last; // key of the last removed event
+    int count;
+
+    // getFirst has to look into the smallest bucket when current is empty,
+    // the answer is kept until the next removal.
+    mutable bool cachedValid;
+    mutable Event cachedFirst;
+
+    static unsigned int keyOf(const Event& e);
+    int bucketOf(unsigned int key) const;
+    void push(int bucket, const Event& e);
+    void rebase(unsigned int newLast);
+    void refill();
+
+    RadixHeap(const RadixHeap& other); // not copyable
+    RadixHeap& operator=(const RadixHeap& other);
+
+public:
+    RadixHeap();
+    ~RadixHeap();
+    void add(const Event& data);
+    Event removeSmallest();
+    bool isEmpty() const;
+    int length() const;
+    Event getFirst() const;
+    Event getLast() const;
+    void copyTo(Event* out) const;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "Random.h"
+
+static unsigned long long rotl(unsigned long long x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static unsigned long long splitmix64(unsigned long long& x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    unsigned long long z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+Random::Random(unsigned long long seed, int stream)
+{
+    for (int i = 0; i < 4; i++) {
+        s[i] = splitmix64(seed);
+    }
+    for (int i = 0; i < stream; i++) {
+        jump();
+    }
+}
+
+unsigned long long Random::next()
+{
+    unsigned long long result = rotl(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+void Random::jump()
+{
+    static const unsigned long long JUMP[4] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+        0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+    unsigned long long t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ull << b)) {
+                for (int j = 0; j < 4; j++) {
+                    t[j] ^= s[j];
+                }
+            }
+            next();
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        s[j] = t[j];
+    }
+}
+
+int Random::nextInt(int bound)
+{
+    if (bound <= 0) {
+        return 0;
+    }
+    // top 32 bits scaled to the bound, no division.
+    return (int)(((next() >> 32) * (unsigned long long)bound) >> 32);
+}
+
+double Random::nextDouble()
+{
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,21 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// xoshiro256** generator. The state is seeded with splitmix64, and stream k
+// is the seeded state jumped ahead k times by 2^128 draws, so streams of
+// the same seed never overlap. Same seed and stream, same numbers, on every
+// thread and every machine.
+class Random {
+private:
+    unsigned long long s[4];
+
+    void jump();
+
+public:
+    Random(unsigned long long seed, int stream = 0);
+    unsigned long long next();
+    int nextInt(int bound); // uniform in [0, bound), 0 if bound <= 0
+    double nextDouble();    // uniform in [0, 1)
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "ReplicationRunner.h"
+#include "Random.h"
+#include <thread>
+#include <vector>
+
+ReplicationRunner::ReplicationRunner(const HospitalScenario& scenario, int numReplications, unsigned long long seed)
+{
+    this->scenario = scenario;
+    this->numReplications = numReplications > 0 ? numReplications : 0;
+    this->seed = seed;
+    numThreads = 0;
+    traces = NULL;
+    // value-initialised, every field 0 until its replication runs
+    results = new DESStatistics[this->numReplications > 0 ? this->numReplications : 1]();
+    for (int i = 0; i < this->numReplications; i++) {
+        results[i].finishTime = -1; // no events yet
+    }
+}
+
+ReplicationRunner::~ReplicationRunner()
+{
+    delete[] results;
+}
+
+void ReplicationRunner::setThreads(int n)
+{
+    numThreads = n > 0 ? n : 0;
+}
+
+void ReplicationRunner::setTraceStreams(std::ostream** streams)
+{
+    traces = streams;
+}
+
+void ReplicationRunner::runReplication(int i)
+{
+    Random rng(seed, i);
+    int n = scenario.numPatients;
+    int* arrivals = new int[n];
+    int* urgencies = new int[n];
+    int now = 0;
+    for (int p = 0; p < n; p++) {
+        now += rng.nextInt(2 * scenario.meanInterarrival + 1);
+        arrivals[p] = now;
+        urgencies[p] = rng.nextInt(scenario.numTiers);
+    }
+
+    DES sim(scenario.numTriages, scenario.numDoctors, scenario.numTiers, scenario.triageDuration,
+            scenario.doctorVisitDuration, scenario.boringDuration, n, urgencies, arrivals);
+    if (traces != NULL && traces[i] != NULL) {
+        sim.setOutputStream(*traces[i]);
+    }
+    else {
+        sim.setSummaryOnly(true);
+    }
+    results[i] = sim.run();
+
+    delete[] arrivals;
+    delete[] urgencies;
+}
+
+void ReplicationRunner::work(ReplicationRunner* runner, std::atomic<int>* next)
+{
+    while (true) {
+        int i = next->fetch_add(1);
+        if (i >= runner->numReplications) {
+            return;
+        }
+        runner->runReplication(i);
+    }
+}
+
+void ReplicationRunner::run()
+{
+    int threads = numThreads;
+    if (threads == 0) {
+        threads = (int)std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+    if (threads > numReplications) {
+        threads = numReplications;
+    }
+
+    std::atomic<int> next(0);
+    // the calling thread is one of the workers.
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.push_back(std::thread(work, this, &next));
+    }
+    work(this, &next);
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+}
+
+const DESStatistics& ReplicationRunner::getResult(int i) const
+{
+    return results[i];
+}
+
+ReplicationSummary ReplicationRunner::summarize() const
+{
+    ReplicationSummary summary;
+    summary.replications = numReplications;
+    summary.eventsProcessed = 0;
+    summary.patientsTreated = 0;
+    summary.patientsBored = 0;
+    summary.meanTreated = 0;
+    summary.meanBored = 0;
+    summary.meanFinishTime = 0;
+    summary.minFinishTime = -1;
+    summary.maxFinishTime = -1;
+    if (numReplications == 0) {
+        return summary;
+    }
+
+    long long finishTimes = 0;
+    for (int i = 0; i < numReplications; i++) {
+        const DESStatistics& r = results[i];
+        summary.eventsProcessed += r.eventsProcessed;
+        summary.patientsTreated += r.patientsTreated;
+        summary.patientsBored += r.patientsBored;
+        finishTimes += r.finishTime;
+        if (i == 0 || r.finishTime < summary.minFinishTime) {
+            summary.minFinishTime = r.finishTime;
+        }
+        if (i == 0 || r.finishTime > summary.maxFinishTime) {
+            summary.maxFinishTime = r.finishTime;
+        }
+    }
+    summary.meanTreated = (double)summary.patientsTreated / numReplications;
+    summary.meanBored = (double)summary.patientsBored / numReplications;
+    summary.meanFinishTime = (double)finishTimes / numReplications;
+    return summary;
+}
@@ -0,0 +1,63 @@
+#ifndef REPLICATIONRUNNER_H
+#define REPLICATIONRUNNER_H
+
+#include "DES.h"
+#include <atomic>
+#include <iostream>
+
+// One hospital configuration. Every replication draws its own patients:
+// arrivals uniform in [0, 2 * meanInterarrival] apart, urgency uniform
+// over the tiers.
+struct HospitalScenario
+{
+    int numTriages, numDoctors, numTiers;
+    int triageDuration, doctorVisitDuration, boringDuration;
+    int numPatients;
+    int meanInterarrival;
+};
+
+// Merged statistics of all replications, always in replication order, so
+// they do not depend on the number of threads.
+struct ReplicationSummary
+{
+    int replications;
+    long long eventsProcessed;
+    long long patientsTreated;
+    long long patientsBored;
+    double meanTreated;
+    double meanBored;
+    double meanFinishTime;
+    int minFinishTime;
+    int maxFinishTime;
+};
+
+// Runs independent DES replications of a scenario on a pool of threads.
+// Replication i uses Random(seed, i) and its own trace stream, so its
+// result does not depend on which thread ran it or when. Threads take the
+// next replication from a shared counter, no replication is bound to one.
+class ReplicationRunner {
+private:
+    HospitalScenario scenario;
+    int numReplications;
+    unsigned long long seed;
+    int numThreads;
+    std::ostream** traces; // one per replication, NULL: traces are dropped
+    DESStatistics* results;
+
+    void runReplication(int i);
+    static void work(ReplicationRunner* runner, std::atomic<int>* next);
+
+    ReplicationRunner(const ReplicationRunner& other); // not copyable
+    ReplicationRunner& operator=(const ReplicationRunner& other);
+
+public:
+    ReplicationRunner(const HospitalScenario& scenario, int numReplications, unsigned long long seed);
+    ~ReplicationRunner();
+    void setThreads(int n); // 0 means one per hardware thread (the default)
+    void setTraceStreams(std::ostream** streams); // caller keeps ownership
+    void run();
+    const DESStatistics& getResult(int i) const;
+    ReplicationSummary summarize() const;
+};
+
+#endif
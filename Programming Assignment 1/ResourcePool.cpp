@@ -0,0 +1,55 @@
+#include "ResourcePool.h"
+
+ResourcePool::ResourcePool(int n) : idle(n)
+{
+    numResources = n > 0 ? n : 0;
+    for (int i = 0; i < numResources; i++) {
+        idle.set(i);
+    }
+}
+
+int ResourcePool::acquire()
+{
+    int id = idle.findFirst();
+    if (id != -1) {
+        idle.clear(id);
+    }
+    return id;
+}
+
+bool ResourcePool::acquire(int id)
+{
+    if (!idle.test(id)) {
+        return false;
+    }
+    idle.clear(id);
+    return true;
+}
+
+void ResourcePool::release(int id)
+{
+    idle.set(id);
+}
+
+bool ResourcePool::isAvailable(int id) const
+{
+    return idle.test(id);
+}
+
+bool ResourcePool::hasAvailable() const
+{
+    return !idle.isEmpty();
+}
+
+int ResourcePool::size() const
+{
+    return numResources;
+}
+
+int ResourcePool::add()
+{
+    idle.resize(numResources + 1);
+    idle.set(numResources);
+    numResources++;
+    return numResources - 1;
+}
@@ -0,0 +1,25 @@
+#ifndef RESOURCEPOOL_H
+#define RESOURCEPOOL_H
+
+#include "OccupancyBitmap.h"
+
+// Idle resources (triage nurses, doctors, ...) with ids 0 .. n-1.
+// acquire hands out the lowest idle id, the same one a scan from index 0
+// would find, using the bitmap's find-first-set instead of the scan.
+class ResourcePool {
+private:
+    OccupancyBitmap idle; // bit i set while resource i is free
+    int numResources;
+
+public:
+    ResourcePool(int n);
+    int acquire(); // lowest idle id, -1 if everyone is busy
+    bool acquire(int id); // takes this one, false if it is busy
+    void release(int id);
+    bool isAvailable(int id) const;
+    bool hasAvailable() const;
+    int size() const;
+    int add(); // one more resource, idle, returns its id
+};
+
+#endif
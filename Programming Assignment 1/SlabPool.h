@@ -0,0 +1,145 @@
+#ifndef SLABPOOL_H
+#define SLABPOOL_H
+
+#include <cstddef>
+#include <new>
+
+// Fixed size blocks for objects of type T. Freed blocks go to a free list
+// and are handed out again, fresh blocks are carved from slabs that double
+// in size up to MAX_SLAB blocks. A container that keeps a steady size does
+// not touch the heap at all, and a growing one allocates O(log n) times.
+// The pool only hands out memory, constructing T is up to the caller.
+template <typename T>
+class SlabPool {
+private:
+    static const int MAX_SLAB = 1024;
+
+    struct Slab {
+        Slab* next;
+    };
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    Slab* slabs;
+    Slab* lastSlab;
+    FreeBlock* freeList;
+    FreeBlock* lastFree; // the tails make absorb O(1)
+    int nextSlabSize;
+
+    static int roundUp(int size, int align)
+    {
+        return ((size + align - 1) / align) * align;
+    }
+
+    static int blockSize()
+    {
+        int size = (int)sizeof(T) > (int)sizeof(FreeBlock) ? (int)sizeof(T) : (int)sizeof(FreeBlock);
+        return roundUp(size, (int)alignof(T));
+    }
+
+    void addSlab(int n)
+    {
+        // blocks start after the header, keep them aligned.
+        int header = roundUp((int)sizeof(Slab), (int)alignof(T));
+        char* memory = static_cast<char*>(::operator new(header + n * blockSize()));
+        Slab* slab = reinterpret_cast<Slab*>(memory);
+        slab->next = slabs;
+        slabs = slab;
+        if (lastSlab == NULL) {
+            lastSlab = slab;
+        }
+        for (int i = n - 1; i >= 0; i--) {
+            deallocate(memory + header + i * blockSize());
+        }
+    }
+
+    SlabPool(const SlabPool& other); // not copyable
+    SlabPool& operator=(const SlabPool& other);
+
+public:
+    SlabPool() : slabs(0), lastSlab(0), freeList(0), lastFree(0), nextSlabSize(8) {}
+
+    // every block must be given back before the pool goes away.
+    ~SlabPool()
+    {
+        while (slabs != NULL) {
+            Slab* next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+    }
+
+    void* allocate()
+    {
+        if (freeList == NULL) {
+            addSlab(nextSlabSize);
+            if (nextSlabSize < MAX_SLAB) {
+                nextSlabSize *= 2;
+            }
+        }
+        FreeBlock* block = freeList;
+        freeList = freeList->next;
+        if (freeList == NULL) {
+            lastFree = NULL;
+        }
+        return block;
+    }
+
+    void deallocate(void* memory)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(memory);
+        block->next = freeList;
+        freeList = block;
+        if (lastFree == NULL) {
+            lastFree = block;
+        }
+    }
+
+    // Takes over every slab and free block of other in O(1), leaving it
+    // an empty pool. Blocks other handed out are then backed by this pool
+    // and must be given back here; a list moving all its nodes to another
+    // list moves its pool along this way.
+    void absorb(SlabPool& other)
+    {
+        if (&other == this) {
+            return;
+        }
+        if (other.slabs != NULL) {
+            other.lastSlab->next = slabs;
+            slabs = other.slabs;
+            if (lastSlab == NULL) {
+                lastSlab = other.lastSlab;
+            }
+        }
+        if (other.freeList != NULL) {
+            other.lastFree->next = freeList;
+            freeList = other.freeList;
+            if (lastFree == NULL) {
+                lastFree = other.lastFree;
+            }
+        }
+        if (other.nextSlabSize > nextSlabSize) {
+            nextSlabSize = other.nextSlabSize;
+        }
+        other.slabs = NULL;
+        other.lastSlab = NULL;
+        other.freeList = NULL;
+        other.lastFree = NULL;
+        other.nextSlabSize = 8;
+    }
+
+    // makes sure the next n allocates do not touch the heap.
+    void reserve(int n)
+    {
+        int available = 0;
+        for (FreeBlock* f = freeList; f != NULL && available < n; f = f->next) {
+            available++;
+        }
+        if (available < n) {
+            addSlab(n - available);
+        }
+    }
+};
+
+#endif
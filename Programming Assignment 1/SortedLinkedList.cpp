@@ -15,35 +15,18 @@ SortedLinkedList::~SortedLinkedList()
 void SortedLinkedList::add(const Event& data)
 {
     // YOUR CODE GOES HERE
-    if(list.isEmpty()){
-        list.addFront(data);
-        return;
-    }
-    
-    Node<Event>* curr = list.head;
-    while(curr != NULL && !(data < curr->data)){
-        curr = curr->next;
-    }
-    
-    if(curr == NULL){
-        list.addBack(data);
-    }
-    else if(curr == list.head){
-        list.addFront(data);
-    }
-    else{
-        Node<Event>* bc = new Node<Event>(data);
-        bc->next = curr;
-        bc->prev = curr->prev;
-        curr->prev->next = bc;
-        curr->prev = bc;
+    EventKey key(data);
+    LinkedList<EventKey>::iterator curr = list.begin();
+    while(curr != list.end() && !(key < *curr)){
+        ++curr;
     }
+    list.emplace(curr, key);
 }
 
 Event SortedLinkedList::removeSmallest()
 {
     // YOUR CODE GOES HERE
-    return list.removeFront();
+    return list.removeFront().event();
 }
 
 bool SortedLinkedList::isEmpty() const
@@ -51,12 +34,26 @@ bool SortedLinkedList::isEmpty() const
     // YOUR CODE GOES HERE
     return list.isEmpty();
 }
+int SortedLinkedList::length() const
+{
+    return list.length();
+}
+
 Event SortedLinkedList::getFirst() const
 {
-    return list.getFront();
+    return list.getFront().event();
 }
 
 Event SortedLinkedList::getLast() const
 {
-    return list.getBack();   
+    return list.getBack().event();
+}
+
+void SortedLinkedList::copyTo(Event* out) const
+{
+    int i = 0;
+    for (LinkedList<EventKey>::const_iterator curr = list.begin(); curr != list.end(); ++curr) {
+        out[i] = curr->event();
+        i++;
+    }
 }
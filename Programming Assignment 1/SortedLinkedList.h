@@ -2,11 +2,14 @@
 #define SORTEDLINKEDLIST_H
 
 #include "LinkedList.h"
-#include "Event.h"
+#include "EventSet.h"
+#include "EventKey.h"
 
-class SortedLinkedList {
+// Events as EventKeys in a sorted list, so the O(n) insert walk does one
+// integer compare per node.
+class SortedLinkedList : public EventSet {
 private:
-    LinkedList<Event> list;
+    LinkedList<EventKey> list;
 
 public:
     SortedLinkedList();
@@ -14,8 +17,10 @@ public:
     void add(const Event& data);
     Event removeSmallest();
     bool isEmpty() const;
+    int length() const;
     Event getFirst() const;
     Event getLast() const;
+    void copyTo(Event* out) const;
     friend class PriorityQueue;
 };
 
@@ -0,0 +1,260 @@
+#include "StatisticsCollector.h"
+#include "Checkpoint.h"
+
+StatisticsCollector::StatisticsCollector(int numTriages, int numDoctors, int numTiers)
+{
+    this->numTriages = numTriages;
+    this->numDoctors = numDoctors;
+    this->numTiers = numTiers > 0 ? numTiers : 0;
+    int slots = this->numTiers > 0 ? this->numTiers : 1;
+    doctorWait = new LogHistogram[slots];
+    boredInTriage = new long long[slots];
+    boredAtDoctor = new long long[slots];
+    for (int t = 0; t < slots; t++) {
+        boredInTriage[t] = 0;
+        boredAtDoctor[t] = 0;
+    }
+    triageQueueLength = 0;
+    maxTriageQueue = 0;
+    doctorQueueLength = 0;
+    maxDoctorQueue = 0;
+    busyTriages = 0;
+    busyDoctors = 0;
+    triageBusyTime = 0;
+    doctorBusyTime = 0;
+    triageCapacityTime = 0;
+    doctorCapacityTime = 0;
+    started = false;
+    firstTime = 0;
+    lastTime = 0;
+}
+
+StatisticsCollector::~StatisticsCollector()
+{
+    delete[] doctorWait;
+    delete[] boredInTriage;
+    delete[] boredAtDoctor;
+}
+
+// adds up the busy and capacity time since the last call, before a count
+// changes
+void StatisticsCollector::advance(int time)
+{
+    if (!started) {
+        started = true;
+        firstTime = time;
+        lastTime = time;
+        return;
+    }
+    long long elapsed = (long long)time - lastTime;
+    triageBusyTime += busyTriages * elapsed;
+    doctorBusyTime += busyDoctors * elapsed;
+    triageCapacityTime += numTriages * elapsed;
+    doctorCapacityTime += numDoctors * elapsed;
+    lastTime = time;
+}
+
+bool StatisticsCollector::validTier(int tier) const
+{
+    return tier >= 0 && tier < numTiers;
+}
+
+void StatisticsCollector::triageQueueJoined(int time)
+{
+    advance(time);
+    triageQueueLength++;
+    if (triageQueueLength > maxTriageQueue) {
+        maxTriageQueue = triageQueueLength;
+    }
+}
+
+void StatisticsCollector::triageStarted(int time, int waited)
+{
+    advance(time);
+    triageQueueLength--;
+    busyTriages++;
+    triageWait.record(waited);
+}
+
+void StatisticsCollector::triageFinished(int time)
+{
+    advance(time);
+    busyTriages--;
+}
+
+void StatisticsCollector::doctorQueueJoined(int time, int tier)
+{
+    if (!validTier(tier)) {
+        return;
+    }
+    advance(time);
+    doctorQueueLength++;
+    if (doctorQueueLength > maxDoctorQueue) {
+        maxDoctorQueue = doctorQueueLength;
+    }
+}
+
+void StatisticsCollector::doctorStarted(int time, int tier, int waited)
+{
+    advance(time);
+    doctorQueueLength--;
+    busyDoctors++;
+    if (validTier(tier)) {
+        doctorWait[tier].record(waited);
+    }
+}
+
+void StatisticsCollector::doctorFinished(int time, int stayed)
+{
+    advance(time);
+    busyDoctors--;
+    timeInHospital.record(stayed);
+}
+
+void StatisticsCollector::triageQueueBored(int time, int tier)
+{
+    advance(time);
+    triageQueueLength--;
+    if (validTier(tier)) {
+        boredInTriage[tier]++;
+    }
+}
+
+void StatisticsCollector::doctorQueueBored(int time, int tier)
+{
+    advance(time);
+    doctorQueueLength--;
+    if (validTier(tier)) {
+        boredAtDoctor[tier]++;
+    }
+}
+
+void StatisticsCollector::resourcesChanged(int time, int numTriages, int numDoctors)
+{
+    if (started) {
+        advance(time);
+    }
+    this->numTriages = numTriages;
+    this->numDoctors = numDoctors;
+}
+
+const LogHistogram& StatisticsCollector::getTriageWait() const
+{
+    return triageWait;
+}
+
+const LogHistogram& StatisticsCollector::getDoctorWait(int tier) const
+{
+    return doctorWait[tier];
+}
+
+const LogHistogram& StatisticsCollector::getTimeInHospital() const
+{
+    return timeInHospital;
+}
+
+long long StatisticsCollector::getBoredInTriage(int tier) const
+{
+    return validTier(tier) ? boredInTriage[tier] : 0;
+}
+
+long long StatisticsCollector::getBoredAtDoctor(int tier) const
+{
+    return validTier(tier) ? boredAtDoctor[tier] : 0;
+}
+
+int StatisticsCollector::getMaxTriageQueue() const
+{
+    return maxTriageQueue;
+}
+
+int StatisticsCollector::getMaxDoctorQueue() const
+{
+    return maxDoctorQueue;
+}
+
+double StatisticsCollector::getTriageUtilization(int time) const
+{
+    if (!started || time <= firstTime) {
+        return 0;
+    }
+    long long elapsed = (long long)time - lastTime;
+    long long capacity = triageCapacityTime + numTriages * elapsed;
+    if (capacity <= 0) {
+        return 0;
+    }
+    return (double)(triageBusyTime + busyTriages * elapsed) / capacity;
+}
+
+double StatisticsCollector::getDoctorUtilization(int time) const
+{
+    if (!started || time <= firstTime) {
+        return 0;
+    }
+    long long elapsed = (long long)time - lastTime;
+    long long capacity = doctorCapacityTime + numDoctors * elapsed;
+    if (capacity <= 0) {
+        return 0;
+    }
+    return (double)(doctorBusyTime + busyDoctors * elapsed) / capacity;
+}
+
+void StatisticsCollector::save(CheckpointWriter& out) const
+{
+    int slots = numTiers > 0 ? numTiers : 1;
+    out.putInt(numTriages);
+    out.putInt(numDoctors);
+    out.putInt(numTiers);
+    triageWait.save(out);
+    for (int t = 0; t < slots; t++) {
+        doctorWait[t].save(out);
+        out.putInt(boredInTriage[t]);
+        out.putInt(boredAtDoctor[t]);
+    }
+    timeInHospital.save(out);
+    out.putInt(triageQueueLength);
+    out.putInt(maxTriageQueue);
+    out.putInt(doctorQueueLength);
+    out.putInt(maxDoctorQueue);
+    out.putInt(busyTriages);
+    out.putInt(busyDoctors);
+    out.putInt(triageBusyTime);
+    out.putInt(doctorBusyTime);
+    out.putInt(triageCapacityTime);
+    out.putInt(doctorCapacityTime);
+    out.putBool(started);
+    out.putInt(firstTime);
+    out.putInt(lastTime);
+}
+
+bool StatisticsCollector::load(CheckpointReader& in)
+{
+    int slots = numTiers > 0 ? numTiers : 1;
+    numTriages = in.getInt32();
+    numDoctors = in.getInt32();
+    if (in.getInt32() != numTiers) {
+        in.fail();
+        return false;
+    }
+    triageWait.load(in);
+    for (int t = 0; t < slots; t++) {
+        doctorWait[t].load(in);
+        boredInTriage[t] = in.getInt();
+        boredAtDoctor[t] = in.getInt();
+    }
+    timeInHospital.load(in);
+    triageQueueLength = in.getInt32();
+    maxTriageQueue = in.getInt32();
+    doctorQueueLength = in.getInt32();
+    maxDoctorQueue = in.getInt32();
+    busyTriages = in.getInt32();
+    busyDoctors = in.getInt32();
+    triageBusyTime = in.getInt();
+    doctorBusyTime = in.getInt();
+    triageCapacityTime = in.getInt();
+    doctorCapacityTime = in.getInt();
+    started = in.getBool();
+    firstTime = in.getInt32();
+    lastTime = in.getInt32();
+    return !in.failed();
+}
@@ -0,0 +1,76 @@
+#ifndef STATISTICSCOLLECTOR_H
+#define STATISTICSCOLLECTOR_H
+
+#include "LogHistogram.h"
+
+class CheckpointWriter;
+class CheckpointReader;
+
+// Running KPIs of one simulation, fed by DES::processEvent as patients
+// move through the hospital. Everything is updated in O(1) per call and
+// the memory is fixed at construction: a few histograms per tier.
+class StatisticsCollector {
+private:
+    int numTriages, numDoctors, numTiers;
+    LogHistogram triageWait;      // triage queue entrance to triage
+    LogHistogram* doctorWait;     // per tier, doctor queue entrance to doctor
+    LogHistogram timeInHospital;  // of treated patients
+    long long* boredInTriage;     // per tier
+    long long* boredAtDoctor;     // per tier
+
+    int triageQueueLength;
+    int maxTriageQueue;
+    int doctorQueueLength; // all tiers
+    int maxDoctorQueue;
+
+    // busy and existing resources times time, added up whenever a count
+    // changes
+    int busyTriages;
+    int busyDoctors;
+    long long triageBusyTime;
+    long long doctorBusyTime;
+    long long triageCapacityTime;
+    long long doctorCapacityTime;
+    bool started; // false before the first call
+    int firstTime;
+    int lastTime;
+
+    void advance(int time);
+    bool validTier(int tier) const;
+
+    StatisticsCollector(const StatisticsCollector& other); // not copyable
+    StatisticsCollector& operator=(const StatisticsCollector& other);
+
+public:
+    StatisticsCollector(int numTriages, int numDoctors, int numTiers);
+    ~StatisticsCollector();
+
+    void triageQueueJoined(int time);
+    void triageStarted(int time, int waited);
+    void triageFinished(int time);
+    void doctorQueueJoined(int time, int tier);
+    void doctorStarted(int time, int tier, int waited);
+    void doctorFinished(int time, int stayed);
+    void triageQueueBored(int time, int tier);
+    void doctorQueueBored(int time, int tier);
+    // resources were added, utilization counts them from time on
+    void resourcesChanged(int time, int numTriages, int numDoctors);
+
+    void save(CheckpointWriter& out) const;
+    // the tier count must match the saved one; false on malformed input
+    bool load(CheckpointReader& in);
+
+    const LogHistogram& getTriageWait() const;
+    const LogHistogram& getDoctorWait(int tier) const; // tier must be valid
+    const LogHistogram& getTimeInHospital() const;
+    long long getBoredInTriage(int tier) const; // 0 for an invalid tier
+    long long getBoredAtDoctor(int tier) const;
+    int getMaxTriageQueue() const;
+    int getMaxDoctorQueue() const;
+    // busy share of the resources from the first call up to time, 0 if
+    // no time has passed. Resources count from when they were added.
+    double getTriageUtilization(int time) const;
+    double getDoctorUtilization(int time) const;
+};
+
+#endif
@@ -1,13 +1,13 @@
 #include "TieredFCFSQueue.h"
 
-TieredFCFSQueue::TieredFCFSQueue()  // you may initialize with one tier in default constructor, you may also remove this function if not needed
+TieredFCFSQueue::TieredFCFSQueue() : occupied(1) // you may initialize with one tier in default constructor, you may also remove this function if not needed
 {
     // YOUR CODE GOES HERE
     numTiers = 1;
     tiers = new FCFSQueue[1];
 }
 
-TieredFCFSQueue::TieredFCFSQueue(int k)
+TieredFCFSQueue::TieredFCFSQueue(int k) : occupied(k)
 {
     // YOUR CODE GOES HERE
     numTiers = k;
@@ -29,29 +29,28 @@ void TieredFCFSQueue::enqueue(int patientId, int tier)
     // YOUR CODE GOES HERE
     if(tier >= 0 && tier<numTiers) {
         tiers[tier].enqueue(patientId);
+        occupied.set(tier);
     }
 }
 
 int TieredFCFSQueue::dequeue()
 {
     // YOUR CODE GOES HERE
-    for(int i = 0; i < numTiers; i++){
-        if(!(tiers[i].isEmpty())){
-            return tiers[i].dequeue();
-        }
+    int tier = occupied.findFirst();
+    if (tier == -1) {
+        return -1;
     }
-    return -1;
+    int patientId = tiers[tier].dequeue();
+    if (tiers[tier].isEmpty()) {
+        occupied.clear(tier);
+    }
+    return patientId;
 }
 
 bool TieredFCFSQueue::isEmpty() const
 {
     // YOUR CODE GOES HERE
-    for(int i = 0; i< numTiers; i++){
-        if(!(tiers[i].isEmpty())){
-            return false;
-        }
-    }
-    return true;
+    return occupied.isEmpty();
 }
 
 
@@ -59,21 +58,39 @@ bool TieredFCFSQueue::isEmpty() const
 int TieredFCFSQueue::getFirst() const
 {
     // YOUR CODE GOES HERE
-    for(int i = 0; i< numTiers; i++){
-        if(!(tiers[i].isEmpty())){
-            return tiers[i].getFirst();
-        }
+    int tier = occupied.findFirst();
+    if (tier == -1) {
+        return -1;
     }
-    return -1;
+    return tiers[tier].getFirst();
 }
 
 int TieredFCFSQueue::getLast() const
 {
     // YOUR CODE GOES HERE
-    for(int i = numTiers - 1; i>= 0; i--){
-        if(!(tiers[i].isEmpty())){
-            return tiers[i].getLast();
-        }
+    int tier = occupied.findLast();
+    if (tier == -1) {
+        return -1;
+    }
+    return tiers[tier].getLast();
+}
+
+int TieredFCFSQueue::getLast(int tier) const
+{
+    if (!occupied.test(tier)) {
+        return -1;
+    }
+    return tiers[tier].getLast();
+}
+
+int TieredFCFSQueue::removeBack(int tier)
+{
+    if (!occupied.test(tier)) {
+        return -1;
+    }
+    int patientId = tiers[tier].removeBack();
+    if (tiers[tier].isEmpty()) {
+        occupied.clear(tier);
     }
-    return -1;
+    return patientId;
 }
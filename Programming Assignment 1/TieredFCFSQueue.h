@@ -2,11 +2,13 @@
 #define TIEREDFCFSQUEUE_H
 
 #include "FCFSQueue.h"
+#include "OccupancyBitmap.h"
 
 class TieredFCFSQueue {
 private:
     FCFSQueue* tiers;
     int numTiers;
+    OccupancyBitmap occupied; // bit i set while tiers[i] is not empty
 
 public:
     TieredFCFSQueue(); // you may initialize with one tier in default constructor, you may also remove this function if not needed
@@ -17,6 +19,10 @@ public:
     int getFirst() const;
     int getLast() const;
     bool isEmpty() const;
+
+    // single tier access for patients leaving from the back, -1 if empty
+    int getLast(int tier) const;
+    int removeBack(int tier);
     
     friend class DES;
 };
@@ -0,0 +1,315 @@
+#include "TimingWheel.h"
+#include <cstddef>
+
+// index of the highest set bit + 1, x must not be 0
+static int bitLength(unsigned int x)
+{
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(x);
+#else
+    int n = 0;
+    while (x != 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+TimingWheel::TimingWheel() : occupied(LEVELS * SLOTS)
+{
+    nodes = NULL;
+    nodeCapacity = 0;
+    freeNodes = -1;
+    for (int i = 0; i < LEVELS * SLOTS; i++) {
+        slotHead[i] = -1;
+    }
+    due = NULL;
+    dueHead = 0;
+    dueCount = 0;
+    dueCapacity = 0;
+    now = 0;
+    count = 0;
+}
+
+TimingWheel::~TimingWheel()
+{
+    delete[] nodes;
+    delete[] due;
+}
+
+unsigned int TimingWheel::keyOf(const Event& e)
+{
+    // flipping the sign bit keeps the order of negative times too.
+    return (unsigned int)e.time ^ 0x80000000u;
+}
+
+int TimingWheel::takeNode()
+{
+    if (freeNodes == -1) {
+        int newCapacity = (nodeCapacity == 0) ? 16 : nodeCapacity * 2;
+        TimerNode* bigger = new TimerNode[newCapacity];
+        for (int i = 0; i < nodeCapacity; i++) {
+            bigger[i] = nodes[i];
+        }
+        for (int i = newCapacity - 1; i >= nodeCapacity; i--) {
+            bigger[i].slot = FREE;
+            bigger[i].next = freeNodes;
+            freeNodes = i;
+        }
+        delete[] nodes;
+        nodes = bigger;
+        nodeCapacity = newCapacity;
+    }
+    int handle = freeNodes;
+    freeNodes = nodes[handle].next;
+    return handle;
+}
+
+void TimingWheel::releaseNode(int handle)
+{
+    nodes[handle].slot = FREE;
+    nodes[handle].next = freeNodes;
+    freeNodes = handle;
+}
+
+void TimingWheel::place(int handle)
+{
+    unsigned int key = keyOf(nodes[handle].event);
+    if (key <= now) {
+        insertDue(handle);
+        return;
+    }
+    int level = (bitLength(key ^ now) - 1) / SLOT_BITS;
+    int slot = level * SLOTS + (int)((key >> (level * SLOT_BITS)) & (SLOTS - 1));
+    TimerNode& node = nodes[handle];
+    node.slot = slot;
+    node.prev = -1;
+    node.next = slotHead[slot];
+    if (node.next != -1) {
+        nodes[node.next].prev = handle;
+    }
+    slotHead[slot] = handle;
+    occupied.set(slot);
+}
+
+void TimingWheel::unlink(int handle)
+{
+    TimerNode& node = nodes[handle];
+    if (node.prev != -1) {
+        nodes[node.prev].next = node.next;
+    }
+    else {
+        slotHead[node.slot] = node.next;
+        if (node.next == -1) {
+            occupied.clear(node.slot);
+        }
+    }
+    if (node.next != -1) {
+        nodes[node.next].prev = node.prev;
+    }
+}
+
+void TimingWheel::reserveDue(int n)
+{
+    if (dueCount + n <= dueCapacity) {
+        return;
+    }
+    // slide the live part to the front first, grow only if that is not enough.
+    int live = dueCount - dueHead;
+    int newCapacity = dueCapacity;
+    while (live + n > newCapacity) {
+        newCapacity = (newCapacity == 0) ? 16 : newCapacity * 2;
+    }
+    int* target = (newCapacity == dueCapacity) ? due : new int[newCapacity];
+    for (int i = 0; i < live; i++) {
+        target[i] = due[dueHead + i];
+    }
+    if (target != due) {
+        delete[] due;
+        due = target;
+        dueCapacity = newCapacity;
+    }
+    dueHead = 0;
+    dueCount = live;
+}
+
+void TimingWheel::insertDue(int handle)
+{
+    // new timers are almost always the largest, so search from the back.
+    reserveDue(1);
+    nodes[handle].slot = DUE;
+    int i = dueCount;
+    while (i > dueHead && nodes[handle].event < nodes[due[i - 1]].event) {
+        due[i] = due[i - 1];
+        i--;
+    }
+    due[i] = handle;
+    dueCount++;
+}
+
+void TimingWheel::drainToDue(int slot)
+{
+    // a level 0 slot holds a single time. The list is newest first, so it is
+    // copied backwards and then only ties out of order have to move.
+    int n = 0;
+    for (int h = slotHead[slot]; h != -1; h = nodes[h].next) {
+        n++;
+    }
+    reserveDue(n);
+    int i = dueCount + n;
+    for (int h = slotHead[slot]; h != -1; h = nodes[h].next) {
+        i--;
+        due[i] = h;
+        nodes[h].slot = DUE;
+    }
+    for (int j = dueCount + 1; j < dueCount + n; j++) {
+        int moving = due[j];
+        int k = j;
+        while (k > dueCount && nodes[moving].event < nodes[due[k - 1]].event) {
+            due[k] = due[k - 1];
+            k--;
+        }
+        due[k] = moving;
+    }
+    dueCount += n;
+    slotHead[slot] = -1;
+    occupied.clear(slot);
+}
+
+void TimingWheel::cascade(int slot)
+{
+    // oldest first, so the lists below stay newest first.
+    int h = slotHead[slot];
+    slotHead[slot] = -1;
+    occupied.clear(slot);
+    while (h != -1 && nodes[h].next != -1) {
+        h = nodes[h].next;
+    }
+    while (h != -1) {
+        int prev = nodes[h].prev;
+        place(h);
+        h = prev;
+    }
+}
+
+void TimingWheel::advance()
+{
+    // the due array is used up and count > 0, so some slot ahead has timers.
+    // Find the nearest: the lowest level with a slot after the current one.
+    dueHead = 0;
+    dueCount = 0;
+    while (dueHead == dueCount) {
+        for (int level = 0; level < LEVELS; level++) {
+            int shift = level * SLOT_BITS;
+            int current = (int)((now >> shift) & (SLOTS - 1));
+            int slot = occupied.findNext(level * SLOTS + current + 1);
+            if (slot == -1 || slot >= (level + 1) * SLOTS) {
+                continue;
+            }
+            unsigned int below = (level + 1 == LEVELS) ? 0xffffffffu : (1u << (shift + SLOT_BITS)) - 1;
+            now = (now & ~below) | ((unsigned int)(slot - level * SLOTS) << shift);
+            if (level == 0) {
+                drainToDue(slot);
+            }
+            else {
+                cascade(slot);
+            }
+            break;
+        }
+    }
+}
+
+void TimingWheel::skipCancelled()
+{
+    while (dueHead < dueCount && nodes[due[dueHead]].slot == CANCELLED) {
+        releaseNode(due[dueHead]);
+        dueHead++;
+    }
+}
+
+int TimingWheel::schedule(const Event& timer)
+{
+    if (count == 0) {
+        // nothing pending, so the wheel can start over at this timer.
+        skipCancelled();
+        while (dueHead < dueCount) {
+            releaseNode(due[dueHead]);
+            dueHead++;
+        }
+        dueHead = 0;
+        dueCount = 0;
+        now = keyOf(timer);
+    }
+    int handle = takeNode();
+    nodes[handle].event = timer;
+    place(handle);
+    count++;
+    return handle;
+}
+
+bool TimingWheel::cancel(int handle)
+{
+    if (handle < 0 || handle >= nodeCapacity) {
+        return false;
+    }
+    int slot = nodes[handle].slot;
+    if (slot == FREE || slot == CANCELLED) {
+        return false;
+    }
+    if (slot == DUE) {
+        // cannot leave a hole in the sorted array, drop it when it comes up.
+        nodes[handle].slot = CANCELLED;
+    }
+    else {
+        unlink(handle);
+        releaseNode(handle);
+    }
+    count--;
+    return true;
+}
+
+Event TimingWheel::getFirst()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    skipCancelled();
+    if (dueHead == dueCount) {
+        advance();
+    }
+    return nodes[due[dueHead]].event;
+}
+
+Event TimingWheel::removeSmallest()
+{
+    if (isEmpty()) {
+        return Event();
+    }
+    Event first = getFirst();
+    releaseNode(due[dueHead]);
+    dueHead++;
+    count--;
+    return first;
+}
+
+bool TimingWheel::isEmpty() const
+{
+    return count == 0;
+}
+
+int TimingWheel::length() const
+{
+    return count;
+}
+
+void TimingWheel::copyTo(Event* out) const
+{
+    int i = 0;
+    for (int h = 0; h < nodeCapacity; h++) {
+        if (nodes[h].slot >= 0 || nodes[h].slot == DUE) {
+            out[i] = nodes[h].event;
+            i++;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include "Event.h"
+#include "OccupancyBitmap.h"
+
+// Hierarchical timing wheel for timeouts such as the boredom events of DES.
+// Times are split into 4 bytes and level L has one slot per value of byte L.
+// A timer sits on the level of the highest byte where its time differs from
+// the wheel's current time, so schedule and cancel are O(1) list operations.
+// When the current time reaches a slot of a higher level, its timers are
+// spread over the lower levels (cascade); each timer moves at most 3 times.
+// Timers at the current time wait in a sorted "due" array so they come out
+// in Event::operator< order, ties included.
+class TimingWheel {
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    // where a timer node is, besides the slot number of its list
+    static const int FREE = -1;
+    static const int DUE = -2;
+    static const int CANCELLED = -3; // cancelled while in the due array
+
+    struct TimerNode {
+        Event event;
+        int next;
+        int prev;
+        int slot;
+    };
+
+    TimerNode* nodes; // a handle is an index in here
+    int nodeCapacity;
+    int freeNodes; // free list through next
+
+    int slotHead[LEVELS * SLOTS]; // slot of level L, byte b is L * SLOTS + b
+    OccupancyBitmap occupied;
+
+    int* due; // handles, sorted, live ones in [dueHead, dueCount)
+    int dueHead;
+    int dueCount;
+    int dueCapacity;
+
+    unsigned int now; // key of the current time
+    int count; // timers that are neither fired nor cancelled
+
+    static unsigned int keyOf(const Event& e);
+    int takeNode();
+    void releaseNode(int handle);
+    void place(int handle);
+    void unlink(int handle);
+    void reserveDue(int n);
+    void insertDue(int handle);
+    void drainToDue(int slot);
+    void cascade(int slot);
+    void advance();
+    void skipCancelled();
+
+    TimingWheel(const TimingWheel& other); // not copyable
+    TimingWheel& operator=(const TimingWheel& other);
+
+public:
+    TimingWheel();
+    ~TimingWheel();
+    int schedule(const Event& timer); // returns the handle for cancel
+    bool cancel(int handle);          // false if it already fired or was cancelled
+    Event getFirst();                 // may move the current time forward
+    Event removeSmallest();
+    bool isEmpty() const;
+    int length() const;
+    void copyTo(Event* out) const; // length() pending timers, in no particular order
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "TraceSink.h"
+
+OStreamTraceSink::OStreamTraceSink(std::ostream& os)
+{
+    this->os = &os;
+}
+
+void OStreamTraceSink::setStream(std::ostream& os)
+{
+    this->os = &os;
+}
+
+void OStreamTraceSink::event(const Event& e)
+{
+    *os << e << '\n';
+}
+
+void OStreamTraceSink::simulationFinished()
+{
+    *os << "Simulation finished." << '\n';
+}
+
+void OStreamTraceSink::doctorStack(int doctor, const MonotonicStack& stack)
+{
+    *os << "Monotonic Stack of Doctor " << doctor << " is " << stack << '\n';
+}
+
+void OStreamTraceSink::flush()
+{
+    os->flush();
+}
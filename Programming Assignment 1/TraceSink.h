@@ -0,0 +1,35 @@
+#ifndef TRACESINK_H
+#define TRACESINK_H
+
+#include "Event.h"
+#include "MonotonicStack.h"
+#include <iostream>
+
+// Where DES::run sends its trace. DES hands over what happened, the sink
+// decides how it is written. Events come as they are shown in the trace
+// (a PatientLeaveHospital event already has resource id -1).
+class TraceSink {
+public:
+    virtual ~TraceSink() {}
+    virtual void event(const Event& e) = 0;
+    virtual void simulationFinished() = 0;
+    virtual void doctorStack(int doctor, const MonotonicStack& stack) = 0;
+    virtual void flush() {} // called at the end of run()
+};
+
+// The text trace on an ostream, one '\n' per line and a single flush at
+// the end instead of std::endl on every line.
+class OStreamTraceSink : public TraceSink {
+private:
+    std::ostream* os;
+
+public:
+    OStreamTraceSink(std::ostream& os);
+    void setStream(std::ostream& os);
+    void event(const Event& e);
+    void simulationFinished();
+    void doctorStack(int doctor, const MonotonicStack& stack);
+    void flush();
+};
+
+#endif
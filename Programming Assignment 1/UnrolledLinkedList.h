@@ -0,0 +1,192 @@
+#ifndef UNROLLEDLINKEDLIST_H
+#define UNROLLEDLINKEDLIST_H
+
+#include <iostream>
+#include "SlabPool.h"
+
+// Node of the unrolled list: a small array of elements, sized so that a
+// node takes about two cache lines. Live elements are items[begin, end).
+template <typename T>
+class UnrolledNode {
+public:
+    enum {
+        FITS = (128 - 2 * (int)sizeof(void*) - 2 * (int)sizeof(int)) / (int)sizeof(T),
+        CAPACITY = FITS < 4 ? 4 : FITS
+    };
+
+    T items[CAPACITY];
+    int begin;
+    int end;
+    UnrolledNode* next;
+    UnrolledNode* prev;
+    UnrolledNode() : begin(0), end(0), next(0), prev(0) {}
+};
+
+// Same surface as LinkedList<T>, but elements are stored CAPACITY to a
+// node, so a pointer is followed once per node instead of once per element.
+// Nodes come from a SlabPool like LinkedList's.
+template <typename T>
+class UnrolledLinkedList {
+private:
+    UnrolledNode<T>* head;
+    UnrolledNode<T>* tail;
+    SlabPool<UnrolledNode<T> > nodes;
+    int count;
+
+    UnrolledNode<T>* takeNode(int at);
+    void releaseNode(UnrolledNode<T>* node);
+
+    UnrolledLinkedList(const UnrolledLinkedList& other); // not copyable
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other);
+
+public:
+    UnrolledLinkedList() : head(0), tail(0), count(0) {}
+    ~UnrolledLinkedList();
+    void addFront(const T& data);
+    void addBack(const T& data);
+    T removeFront();
+    T removeBack();
+    bool isEmpty() const;
+    int length() const;
+    T getFront() const;
+    T getBack() const;
+};
+
+template <typename T>
+UnrolledLinkedList<T>::~UnrolledLinkedList()
+{
+    while (head != NULL) {
+        UnrolledNode<T>* next = head->next;
+        head->~UnrolledNode<T>();
+        nodes.deallocate(head);
+        head = next;
+    }
+}
+
+// empty node whose first element will go to index at
+template <typename T>
+UnrolledNode<T>* UnrolledLinkedList<T>::takeNode(int at)
+{
+    UnrolledNode<T>* node = new (nodes.allocate()) UnrolledNode<T>();
+    node->begin = at;
+    node->end = at;
+    return node;
+}
+
+template <typename T>
+void UnrolledLinkedList<T>::releaseNode(UnrolledNode<T>* node)
+{
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    }
+    else {
+        head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+    else {
+        tail = node->prev;
+    }
+    node->~UnrolledNode<T>();
+    nodes.deallocate(node);
+}
+
+template <typename T>
+void UnrolledLinkedList<T>::addFront(const T& data)
+{
+    if (head == NULL) {
+        // start in the middle so both ends have room.
+        head = takeNode(UnrolledNode<T>::CAPACITY / 2);
+        tail = head;
+    }
+    else if (head->begin == 0) {
+        UnrolledNode<T>* node = takeNode(UnrolledNode<T>::CAPACITY);
+        node->next = head;
+        head->prev = node;
+        head = node;
+    }
+    head->begin--;
+    head->items[head->begin] = data;
+    count++;
+}
+
+template <typename T>
+void UnrolledLinkedList<T>::addBack(const T& data)
+{
+    if (tail == NULL) {
+        tail = takeNode(UnrolledNode<T>::CAPACITY / 2);
+        head = tail;
+    }
+    else if (tail->end == UnrolledNode<T>::CAPACITY) {
+        UnrolledNode<T>* node = takeNode(0);
+        node->prev = tail;
+        tail->next = node;
+        tail = node;
+    }
+    tail->items[tail->end] = data;
+    tail->end++;
+    count++;
+}
+
+template <typename T>
+T UnrolledLinkedList<T>::removeFront()
+{
+    if (isEmpty()) {
+        return T();
+    }
+    T data = head->items[head->begin];
+    head->begin++;
+    count--;
+    if (head->begin == head->end) {
+        releaseNode(head);
+    }
+    return data;
+}
+
+template <typename T>
+T UnrolledLinkedList<T>::removeBack()
+{
+    if (isEmpty()) {
+        return T();
+    }
+    tail->end--;
+    T data = tail->items[tail->end];
+    count--;
+    if (tail->begin == tail->end) {
+        releaseNode(tail);
+    }
+    return data;
+}
+
+template <typename T>
+bool UnrolledLinkedList<T>::isEmpty() const
+{
+    return count == 0;
+}
+
+template <typename T>
+int UnrolledLinkedList<T>::length() const
+{
+    return count;
+}
+
+template <typename T>
+T UnrolledLinkedList<T>::getFront() const
+{
+    if (isEmpty()) {
+        return T();
+    }
+    return head->items[head->begin];
+}
+
+template <typename T>
+T UnrolledLinkedList<T>::getBack() const
+{
+    if (isEmpty()) {
+        return T();
+    }
+    return tail->items[tail->end - 1];
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+// LEB128 style variable length integers: 7 bits per byte, low bits first,
+// the high bit set on every byte but the last. Signed values are zigzag
+// encoded first so small negative numbers stay short. Shared by the binary
+// trace and DES checkpoints.
+
+static const int MAX_VARINT = 10; // bytes of the longest 64 bit varint
+
+inline unsigned long long zigzag(long long v)
+{
+    return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63);
+}
+
+inline long long unzigzag(unsigned long long v)
+{
+    return (long long)(v >> 1) ^ -(long long)(v & 1);
+}
+
+inline int putVarint(unsigned char* p, unsigned long long v)
+{
+    int n = 0;
+    while (v >= 0x80) {
+        p[n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (unsigned char)v;
+    return n;
+}
+
+// decodes a varint at p, never reads at or past end
+inline const unsigned char* getVarint(const unsigned char* p, const unsigned char* end, unsigned long long& v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char b = *p++;
+        v |= (unsigned long long)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            return p;
+        }
+    }
+    return end;
+}
+
+inline int putSigned(unsigned char* p, long long v)
+{
+    return putVarint(p, zigzag(v));
+}
+
+inline const unsigned char* getSigned(const unsigned char* p, const unsigned char* end, int& v)
+{
+    unsigned long long u;
+    p = getVarint(p, end, u);
+    v = (int)unzigzag(u);
+    return p;
+}
+
+#endif
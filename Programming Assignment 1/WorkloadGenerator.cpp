@@ -0,0 +1,345 @@
+#include "WorkloadGenerator.h"
+#include "MappedArrivalFile.h"
+#include <climits>
+#include <cmath>
+
+// past this the stream has ended anyway, times no longer fit in an int
+static const double NEVER = 4294967296.0;
+
+WorkloadGenerator::WorkloadGenerator(unsigned long long seed, int stream) : rng(seed, stream)
+{
+    rate = 1.0;
+    profile = NULL;
+    profileSlots = 0;
+    period = 0;
+    burstRate = 0.0;
+    burstSize = 0;
+    burstSpread = 0;
+    regularUrgency.keep = NULL;
+    regularUrgency.alias = NULL;
+    regularUrgency.tiers = 0;
+    burstUrgency.keep = NULL;
+    burstUrgency.alias = NULL;
+    burstUrgency.tiers = 0;
+    limit = -1;
+    endTime = INT_MAX;
+    startTime = 0;
+    started = false;
+    clock = NEVER;
+    nextBurst = NEVER;
+    bursts = NULL;
+    numBursts = 0;
+    burstCapacity = 0;
+    produced = 0;
+}
+
+WorkloadGenerator::~WorkloadGenerator()
+{
+    delete[] profile;
+    freeTable(regularUrgency);
+    freeTable(burstUrgency);
+    delete[] bursts;
+}
+
+void WorkloadGenerator::setArrivalRate(double patientsPerTimeUnit)
+{
+    rate = patientsPerTimeUnit > 0.0 ? patientsPerTimeUnit : 0.0;
+}
+
+bool WorkloadGenerator::setDailyProfile(int newPeriod, const double* multipliers, int slots)
+{
+    if (newPeriod <= 0 || slots <= 0) {
+        return false;
+    }
+    bool anyPositive = false;
+    for (int i = 0; i < slots; i++) {
+        if (multipliers[i] > 0.0) {
+            anyPositive = true;
+        }
+    }
+    if (!anyPositive) {
+        return false;
+    }
+    delete[] profile;
+    profile = new double[slots];
+    for (int i = 0; i < slots; i++) {
+        profile[i] = multipliers[i] > 0.0 ? multipliers[i] : 0.0;
+    }
+    profileSlots = slots;
+    period = newPeriod;
+    return true;
+}
+
+void WorkloadGenerator::setBursts(double burstsPerTimeUnit, int patientsPerBurst, int spread)
+{
+    if (burstsPerTimeUnit <= 0.0 || patientsPerBurst <= 0) {
+        burstRate = 0.0;
+        burstSize = 0;
+        burstSpread = 0;
+        return;
+    }
+    burstRate = burstsPerTimeUnit;
+    burstSize = patientsPerBurst;
+    burstSpread = spread > 0 ? spread : 0;
+}
+
+void WorkloadGenerator::freeTable(UrgencyTable& table)
+{
+    delete[] table.keep;
+    delete[] table.alias;
+    table.keep = NULL;
+    table.alias = NULL;
+    table.tiers = 0;
+}
+
+bool WorkloadGenerator::buildTable(UrgencyTable& table, const double* weights, int tiers)
+{
+    if (tiers <= 0) {
+        return false;
+    }
+    double total = 0.0;
+    for (int i = 0; i < tiers; i++) {
+        if (weights[i] > 0.0) {
+            total += weights[i];
+        }
+    }
+    if (total <= 0.0) {
+        return false;
+    }
+    freeTable(table);
+    table.keep = new unsigned long long[tiers];
+    table.alias = new int[tiers];
+    table.tiers = tiers;
+
+    // Vose's method: scale to mean 1, then let every slot below 1 be topped
+    // up by one above 1. small and large are stacks of slot indices.
+    double* scaled = new double[tiers];
+    int* small = new int[tiers];
+    int* large = new int[tiers];
+    int numSmall = 0;
+    int numLarge = 0;
+    for (int i = 0; i < tiers; i++) {
+        scaled[i] = (weights[i] > 0.0 ? weights[i] : 0.0) * tiers / total;
+        if (scaled[i] < 1.0) {
+            small[numSmall] = i;
+            numSmall++;
+        }
+        else {
+            large[numLarge] = i;
+            numLarge++;
+        }
+    }
+    while (numSmall > 0 && numLarge > 0) {
+        numSmall--;
+        int s = small[numSmall];
+        int l = large[numLarge - 1];
+        table.keep[s] = (unsigned long long)(scaled[s] * 4294967296.0);
+        table.alias[s] = l;
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            numLarge--;
+            small[numSmall] = l;
+            numSmall++;
+        }
+    }
+    // whatever is left is 1 up to rounding, so it always keeps its tier.
+    for (int i = 0; i < numLarge; i++) {
+        table.keep[large[i]] = 4294967296ull;
+        table.alias[large[i]] = large[i];
+    }
+    for (int i = 0; i < numSmall; i++) {
+        table.keep[small[i]] = 4294967296ull;
+        table.alias[small[i]] = small[i];
+    }
+    delete[] scaled;
+    delete[] small;
+    delete[] large;
+    return true;
+}
+
+bool WorkloadGenerator::setUrgencyWeights(const double* weights, int tiers)
+{
+    return buildTable(regularUrgency, weights, tiers);
+}
+
+bool WorkloadGenerator::setBurstUrgencyWeights(const double* weights, int tiers)
+{
+    return buildTable(burstUrgency, weights, tiers);
+}
+
+void WorkloadGenerator::setStartTime(int time)
+{
+    startTime = time;
+}
+
+void WorkloadGenerator::setEndTime(int time)
+{
+    endTime = time;
+}
+
+void WorkloadGenerator::setPatientLimit(long long n)
+{
+    limit = n < 0 ? 0 : n;
+}
+
+double WorkloadGenerator::exponential()
+{
+    // 1 - u is in (0, 1], so the log is finite.
+    return -std::log(1.0 - rng.nextDouble());
+}
+
+double WorkloadGenerator::floorOf(double x)
+{
+    // std::floor is a library call without SSE4.1, this is on every patient.
+    double t = (double)(long long)x;
+    return t > x ? t - 1.0 : t;
+}
+
+double WorkloadGenerator::advance(double from, double hazard) const
+{
+    // time at which the integrated arrival rate since from reaches hazard.
+    if (profile == NULL) {
+        return from + hazard / rate;
+    }
+    // the rate is constant within a slot, so walk slot by slot. Period 0
+    // starts at time 0.
+    double slotLength = (double)period / profileSlots;
+    double periodStart = std::floor(from / period) * period;
+    int slot = (int)((from - periodStart) / slotLength);
+    if (slot >= profileSlots) {
+        slot = profileSlots - 1;
+    }
+    while (from < NEVER) {
+        double slotEnd = periodStart + (slot + 1) * slotLength;
+        double slotRate = rate * profile[slot];
+        double available = slotRate * (slotEnd - from);
+        if (slotRate > 0.0 && available >= hazard) {
+            return from + hazard / slotRate;
+        }
+        hazard -= available;
+        from = slotEnd;
+        slot++;
+        if (slot == profileSlots) {
+            slot = 0;
+            periodStart += period;
+        }
+    }
+    return NEVER;
+}
+
+void WorkloadGenerator::start()
+{
+    started = true;
+    clock = rate > 0.0 ? advance(startTime, exponential()) : NEVER;
+    nextBurst = burstSize > 0 ? startTime + exponential() / burstRate : NEVER;
+}
+
+int WorkloadGenerator::drawUrgency(const UrgencyTable& table)
+{
+    if (table.keep == NULL) {
+        return 0;
+    }
+    unsigned long long u = rng.next();
+    int slot = (int)(((u >> 32) * (unsigned long long)table.tiers) >> 32);
+    return (u & 0xffffffffull) < table.keep[slot] ? slot : table.alias[slot];
+}
+
+bool WorkloadGenerator::next(int& arrivalTime, int& urgencyLevel)
+{
+    if (!started) {
+        start();
+    }
+    if (limit >= 0 && produced >= limit) {
+        return false;
+    }
+    while (true) {
+        // earliest patient: the regular one wins ties, then older bursts.
+        double when = floorOf(clock);
+        int fromBurst = -1;
+        for (int i = 0; i < numBursts; i++) {
+            const ActiveBurst& b = bursts[i];
+            double t = b.start + (double)((long long)b.sent * b.spread / b.size);
+            if (t < when) {
+                when = t;
+                fromBurst = i;
+            }
+        }
+        double onset = floorOf(nextBurst);
+        if (onset <= when && onset < endTime) {
+            // the burst's first patient may come before everything else.
+            if (numBursts == burstCapacity) {
+                int newCapacity = burstCapacity == 0 ? 4 : burstCapacity * 2;
+                ActiveBurst* bigger = new ActiveBurst[newCapacity];
+                for (int i = 0; i < numBursts; i++) {
+                    bigger[i] = bursts[i];
+                }
+                delete[] bursts;
+                bursts = bigger;
+                burstCapacity = newCapacity;
+            }
+            ActiveBurst& b = bursts[numBursts];
+            b.start = (int)onset;
+            b.size = burstSize;
+            b.spread = burstSpread;
+            b.sent = 0;
+            numBursts++;
+            nextBurst += exponential() / burstRate;
+            continue;
+        }
+        if (when >= endTime) {
+            return false;
+        }
+        arrivalTime = (int)when;
+        if (fromBurst < 0) {
+            urgencyLevel = drawUrgency(regularUrgency);
+            clock = advance(clock, exponential());
+        }
+        else {
+            const UrgencyTable& table = burstUrgency.keep != NULL ? burstUrgency : regularUrgency;
+            urgencyLevel = drawUrgency(table);
+            ActiveBurst& b = bursts[fromBurst];
+            b.sent++;
+            if (b.sent == b.size) {
+                // keep the rest in onset order for the tie break.
+                for (int i = fromBurst + 1; i < numBursts; i++) {
+                    bursts[i - 1] = bursts[i];
+                }
+                numBursts--;
+            }
+        }
+        produced++;
+        return true;
+    }
+}
+
+int WorkloadGenerator::generate(int* arrivalTimes, int* urgencyLevels, int n)
+{
+    int written = 0;
+    while (written < n && next(arrivalTimes[written], urgencyLevels[written])) {
+        written++;
+    }
+    return written;
+}
+
+long long WorkloadGenerator::writeCsv(std::ostream& os, long long n)
+{
+    long long written = 0;
+    int t, u;
+    while (written < n && next(t, u)) {
+        os << t << ',' << u << '\n';
+        written++;
+    }
+    return written;
+}
+
+long long WorkloadGenerator::writeBinary(std::ostream& os, long long n)
+{
+    MappedArrivalFile::writeBinaryHeader(os);
+    long long written = 0;
+    int t, u;
+    while (written < n && next(t, u)) {
+        MappedArrivalFile::writeBinaryRecord(os, t, u);
+        written++;
+    }
+    return written;
+}
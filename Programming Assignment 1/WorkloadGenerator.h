@@ -0,0 +1,95 @@
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "ArrivalSource.h"
+#include "Random.h"
+#include <iostream>
+
+// Synthetic patients for scale tests, in arrival order.
+//   regular arrivals  Poisson process of setArrivalRate patients per time
+//                     unit, optionally scaled by a repeating daily profile
+//   bursts            mass casualty events, a Poisson process of their own;
+//                     each brings patientsPerBurst patients spread evenly
+//                     over the next spread time units
+// Urgencies are drawn from separate weights for regular and burst patients.
+// The stream ends at the patient limit, at the end time, or when times
+// would no longer fit in an int. Same seed and stream, same patients.
+// Configure before the first patient is drawn.
+class WorkloadGenerator : public ArrivalSource {
+private:
+    // Walker's alias table: a draw picks slot i uniformly and keeps tier i
+    // if its low 32 bits are below keep[i], else takes alias[i]. One draw
+    // and no data dependent branch per patient, whatever the tier count.
+    struct UrgencyTable {
+        unsigned long long* keep;
+        int* alias;
+        int tiers;
+    };
+
+    struct ActiveBurst {
+        int start;
+        int size;
+        int spread;
+        int sent; // patients of the burst already drawn
+    };
+
+    Random rng;
+    double rate;
+    double* profile; // rate multiplier per slot of the period, NULL if flat
+    int profileSlots;
+    int period;
+    double burstRate;
+    int burstSize;
+    int burstSpread;
+    UrgencyTable regularUrgency;
+    UrgencyTable burstUrgency; // keep NULL: same as regularUrgency
+    long long limit; // -1 if none
+    int endTime;
+    int startTime;
+
+    bool started;
+    double clock;     // next regular arrival, exact
+    double nextBurst; // onset of the next burst
+    ActiveBurst* bursts;
+    int numBursts;
+    int burstCapacity;
+    long long produced;
+
+    void start();
+    double exponential();
+    static double floorOf(double x);
+    double advance(double from, double hazard) const;
+    static bool buildTable(UrgencyTable& table, const double* weights, int tiers);
+    static void freeTable(UrgencyTable& table);
+    int drawUrgency(const UrgencyTable& table);
+
+    WorkloadGenerator(const WorkloadGenerator& other); // not copyable
+    WorkloadGenerator& operator=(const WorkloadGenerator& other);
+
+public:
+    WorkloadGenerator(unsigned long long seed, int stream = 0);
+    ~WorkloadGenerator();
+    void setArrivalRate(double patientsPerTimeUnit); // 1 by default, 0 for bursts only
+    // Slot i of every period of the given length has the arrival rate
+    // times multipliers[i]. False, and nothing changes, if period or slots
+    // is not positive or no multiplier is.
+    bool setDailyProfile(int period, const double* multipliers, int slots);
+    void setBursts(double burstsPerTimeUnit, int patientsPerBurst, int spread);
+    // Tier i is drawn with weight weights[i]; everyone is urgency 0 until
+    // this is called. False, and nothing changes, if no weight is positive.
+    bool setUrgencyWeights(const double* weights, int tiers);
+    bool setBurstUrgencyWeights(const double* weights, int tiers);
+    void setStartTime(int time); // 0 by default
+    void setEndTime(int time); // no patient arrives at or after time
+    void setPatientLimit(long long n);
+
+    bool next(int& arrivalTime, int& urgencyLevel);
+    // Up to n patients into the arrays, returns how many were written.
+    int generate(int* arrivalTimes, int* urgencyLevels, int n);
+    // Up to n patients as "arrivalTime,urgencyLevel" lines, or as a whole
+    // MappedArrivalFile binary file, header included. Returns how many.
+    long long writeCsv(std::ostream& os, long long n);
+    long long writeBinary(std::ostream& os, long long n);
+};
+
+#endif
@@ -0,0 +1,64 @@
+// Runs the same DES traces on every event set engine and reports wall time.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp event_set_compare.cpp -o event_set_compare
+// usage: ./event_set_compare [numPatients] [seed]
+#include "DES.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+static const char* engineName(EventSetEngine engine)
+{
+    if (engine == SortedListEngine) {
+        return "sorted-list";
+    }
+    if (engine == CalendarEngine) {
+        return "calendar";
+    }
+    if (engine == RadixEngine) {
+        return "radix";
+    }
+    if (engine == IntrusiveListEngine) {
+        return "intrusive-list";
+    }
+    return "heap";
+}
+
+int main(int argc, char** argv)
+{
+    int numPatients = (argc > 1) ? atoi(argv[1]) : 20000;
+    unsigned int seed = (argc > 2) ? (unsigned int)atoi(argv[2]) : 1;
+
+    // arrivals a few time units apart, like a busy emergency department.
+    int* arrivals = new int[numPatients];
+    int* urgencies = new int[numPatients];
+    int now = 0;
+    for (int i = 0; i < numPatients; i++) {
+        seed = seed * 1103515245u + 12345u;
+        now += (int)((seed >> 16) % 4);
+        arrivals[i] = now;
+        urgencies[i] = (int)((seed >> 8) % 5);
+    }
+
+    // the trace itself is not what we measure, so switch cout off.
+    std::streambuf* saved = std::cout.rdbuf(NULL);
+    EventSetEngine engines[5] = {HeapEngine, CalendarEngine, RadixEngine, IntrusiveListEngine, SortedListEngine};
+    double seconds[5];
+    for (int i = 0; i < 5; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        DES sim(4, 8, 5, 3, 20, 40, numPatients, urgencies, arrivals, engines[i]);
+        sim.run();
+        seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    std::cout << "patients: " << numPatients << std::endl;
+    for (int i = 0; i < 5; i++) {
+        std::cout << engineName(engines[i]) << ": " << seconds[i] << " s"
+                  << " (" << seconds[4] / seconds[i] << "x sorted-list)" << std::endl;
+    }
+
+    delete[] arrivals;
+    delete[] urgencies;
+    return 0;
+}
@@ -0,0 +1,100 @@
+// A ring of busy hospitals, each sending patients on to the next, run
+// sequentially and in windows on 1, 2, 4, ... threads.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp network_bench.cpp -o network_bench
+// usage: ./network_bench [hospitals] [numPatients] [delay] [maxThreads]
+#include "HospitalNetwork.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+static int numHospitals;
+static int numPatients;
+static int delay;
+static int** arrivals;
+static int** urgencies;
+
+// summary only, the network owns nothing so the caller deletes them
+static void makeRing(DES** hospitals, HospitalNetwork*& network)
+{
+    for (int h = 0; h < numHospitals; h++) {
+        hospitals[h] = new DES(4, 8, 5, 3, 20, 40, numPatients, urgencies[h], arrivals[h]);
+        hospitals[h]->setSummaryOnly(true);
+    }
+    network = new HospitalNetwork(hospitals, numHospitals);
+    for (int h = 0; h < numHospitals; h++) {
+        network->setTransfer(h, (h + 1) % numHospitals, delay + h % 3, 6);
+    }
+}
+
+static long long finish(DES** hospitals, HospitalNetwork* network)
+{
+    long long events = 0;
+    for (int h = 0; h < numHospitals; h++) {
+        events += hospitals[h]->getStatistics().eventsProcessed;
+        delete hospitals[h];
+    }
+    delete network;
+    return events;
+}
+
+int main(int argc, char** argv)
+{
+    numHospitals = (argc > 1) ? atoi(argv[1]) : 8;
+    numPatients = (argc > 2) ? atoi(argv[2]) : 200000;
+    delay = (argc > 3) ? atoi(argv[3]) : 30;
+    int maxThreads = (argc > 4) ? atoi(argv[4]) : (int)std::thread::hardware_concurrency();
+    if (numHospitals < 2 || delay < 1) {
+        std::cerr << "usage: ./network_bench [hospitals >= 2] [numPatients] [delay >= 1] [maxThreads]" << std::endl;
+        return 1;
+    }
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    arrivals = new int*[numHospitals];
+    urgencies = new int*[numHospitals];
+    for (int h = 0; h < numHospitals; h++) {
+        Random rng(1, h);
+        arrivals[h] = new int[numPatients];
+        urgencies[h] = new int[numPatients];
+        int now = 0;
+        for (int i = 0; i < numPatients; i++) {
+            now += rng.nextInt(3);
+            arrivals[h][i] = now;
+            urgencies[h][i] = rng.nextInt(5);
+        }
+    }
+    std::cout << "hospitals: " << numHospitals << ", patients each: " << numPatients << ", delay: " << delay << std::endl;
+
+    DES** hospitals = new DES*[numHospitals];
+    HospitalNetwork* network;
+    makeRing(hospitals, network);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    network->runSequential();
+    double sequential = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    long long events = finish(hospitals, network);
+    std::cout << "sequential: " << sequential << " s, " << events / sequential << " events/s" << std::endl;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        makeRing(hospitals, network);
+        network->setThreads(threads);
+        start = std::chrono::steady_clock::now();
+        network->run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        long long windows = network->getWindows();
+        events = finish(hospitals, network);
+        std::cout << threads << " threads: " << seconds << " s, " << events / seconds << " events/s ("
+                  << sequential / seconds << "x), " << windows << " windows" << std::endl;
+    }
+
+    for (int h = 0; h < numHospitals; h++) {
+        delete[] arrivals[h];
+        delete[] urgencies[h];
+    }
+    delete[] arrivals;
+    delete[] urgencies;
+    delete[] hospitals;
+    return 0;
+}
@@ -0,0 +1,523 @@
+// Microbenchmarks of the PA1 containers, the event set engines and DES::run,
+// at sizes 10, 100, ... up to --max-size. Results go to stdout as JSON:
+// {"benchmarks": [{"name", "size", "operations", "seconds", "ns_per_op"}, ...]}
+//
+// containers   fill to size, then drain, repeated until about 2^20
+//              operations are timed; ns_per_op counts pushes and pops.
+// hold         classic hold model: the set starts with size events, every
+//              operation removes the smallest and adds it back later by a
+//              random increment, so the size stays put.
+// markov_hold  each operation is an add or a remove with even odds, so the
+//              size wanders around its start value.
+// move_run     a run of size events moved to another list and back, one
+//              element at a time and with LinkedList::splice.
+// event_sort   std::sort of size events with many equal times, compared
+//              by Event::operator< and as packed EventKeys, ns per event.
+// des          DES::run on a synthetic busy hospital, ns per processed event,
+//              with the trace formatted into a discarding stream and in
+//              summary only mode. des/fork times DES::fork halfway through
+//              the arrivals, ns per patient of the whole run.
+// workload     WorkloadGenerator filling arrays, ns per patient.
+//
+// The sorted lists insert in O(n), so they stop at --max-sorted.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp pa1_bench.cpp -o pa1_bench
+// add -DDES_PROFILE for a per event type profile of every DES run on stderr
+// usage: ./pa1_bench [--max-size n] [--max-sorted n] [--max-des n] [--filter text] [--seed s]
+#include "DES.h"
+#include "EventKey.h"
+#include "FCFSQueue.h"
+#include "IntrusiveFCFSQueue.h"
+#include "LinkedList.h"
+#include "MonotonicStack.h"
+#include "PriorityQueue.h"
+#include "Random.h"
+#include "SortedLinkedList.h"
+#include "TieredFCFSQueue.h"
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static const long long MIN_OPERATIONS = 1 << 20;
+
+static const char* filter = NULL;
+static bool firstResult = true;
+static long long checksum = 0; // keeps the work from being optimized out
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool selected(const std::string& name)
+{
+    return filter == NULL || name.find(filter) != std::string::npos;
+}
+
+static void report(const std::string& name, int size, long long operations, double seconds)
+{
+    std::cout << (firstResult ? "\n" : ",\n");
+    firstResult = false;
+    std::cout << "    {\"name\": \"" << name << "\", \"size\": " << size << ", \"operations\": " << operations
+              << ", \"seconds\": " << seconds << ", \"ns_per_op\": " << seconds * 1e9 / (double)operations << "}";
+    std::cout.flush();
+}
+
+static int roundsFor(int size)
+{
+    long long rounds = MIN_OPERATIONS / (2LL * size);
+    return rounds < 1 ? 1 : (int)rounds;
+}
+
+// exponential increments with mean 100, drawn up front so the hold loops
+// time the event set and not std::log.
+static const int NUM_INCREMENTS = 1 << 16;
+static int increments[NUM_INCREMENTS];
+
+static void drawIncrements(Random& rng)
+{
+    for (int i = 0; i < NUM_INCREMENTS; i++) {
+        int v = (int)(-100.0 * std::log(1.0 - rng.nextDouble()));
+        increments[i] = v < 1 ? 1 : v;
+    }
+}
+
+static int increment(long long i)
+{
+    return increments[i & (NUM_INCREMENTS - 1)];
+}
+
+// the sorted lists are O(size) per operation, keep their runs short.
+static long long holdOperations(EventSetEngine engine, int size)
+{
+    if ((engine == SortedListEngine || engine == IntrusiveListEngine) && size > 10) {
+        long long operations = MIN_OPERATIONS * 10 / size;
+        return operations < 1000 ? 1000 : operations;
+    }
+    return MIN_OPERATIONS;
+}
+
+static void benchLinkedList(int size)
+{
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    LinkedList<int> list;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            list.addBack(i);
+        }
+        while (!list.isEmpty()) {
+            checksum += list.removeFront();
+        }
+    }
+    report("linked_list/push_pop", size, 2LL * rounds * size, secondsSince(start));
+}
+
+static void fillEvents(LinkedList<Event>& list, int size)
+{
+    for (int i = list.length(); i < size; i++) {
+        list.emplaceBack(i, TriageLeave, i, 0);
+    }
+}
+
+// a run of size events going from one list to another and back, element
+// by element and as one splice; ns per event moved.
+static void benchLinkedListRun(int size)
+{
+    int rounds = roundsFor(size);
+    LinkedList<Event> from, to;
+    fillEvents(from, size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        while (!from.isEmpty()) {
+            to.addBack(from.removeFront());
+        }
+        while (!to.isEmpty()) {
+            from.addBack(to.removeFront());
+        }
+    }
+    report("linked_list/move_run/copy", size, 2LL * rounds * size, secondsSince(start));
+    checksum += from.getBack().time;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        to.splice(to.end(), from);
+        from.splice(from.end(), to);
+    }
+    report("linked_list/move_run/splice", size, 2LL * rounds * size, secondsSince(start));
+    checksum += from.getBack().time;
+}
+
+static void benchFCFSQueue(int size)
+{
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    FCFSQueue queue;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            queue.enqueue(i);
+        }
+        while (!queue.isEmpty()) {
+            checksum += queue.dequeue();
+        }
+    }
+    report("fcfs_queue/push_pop", size, 2LL * rounds * size, secondsSince(start));
+}
+
+static void benchIntrusiveFCFSQueue(int size)
+{
+    // the records are made once, the queue only relinks them.
+    PatientTable patients;
+    patients.reserve(size);
+    for (int i = 0; i < size; i++) {
+        patients.add(i % 5);
+    }
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    IntrusiveFCFSQueue queue(patients);
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            queue.enqueue(i);
+        }
+        while (!queue.isEmpty()) {
+            checksum += queue.dequeue();
+        }
+    }
+    report("intrusive_fcfs_queue/push_pop", size, 2LL * rounds * size, secondsSince(start));
+}
+
+static void benchTieredFCFSQueue(int size, Random& rng)
+{
+    const int TIERS = 5;
+    int* tiers = new int[size];
+    for (int i = 0; i < size; i++) {
+        tiers[i] = rng.nextInt(TIERS);
+    }
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TieredFCFSQueue queue(TIERS);
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            queue.enqueue(i, tiers[i]);
+        }
+        while (!queue.isEmpty()) {
+            checksum += queue.dequeue();
+        }
+    }
+    report("tiered_fcfs_queue/push_pop", size, 2LL * rounds * size, secondsSince(start));
+    delete[] tiers;
+}
+
+static void benchMonotonicStack(int size)
+{
+    // increasing ids are all kept, so the stack really grows to size.
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MonotonicStack stack;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            stack.push(i);
+        }
+        while (!stack.isEmpty()) {
+            checksum += stack.pop();
+        }
+    }
+    report("monotonic_stack/push_pop", size, 2LL * rounds * size, secondsSince(start));
+}
+
+static void benchMonotonicTruncate(int size)
+{
+    // odd ids up to 2 * size, then an even push that cuts the stack back
+    // to half and is popped again.
+    int rounds = roundsFor(size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MonotonicStack stack;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = stack.length(); i < size; i++) {
+            stack.push(2 * i + 1);
+        }
+        stack.push(size - size % 2);
+        checksum += stack.pop();
+    }
+    report("monotonic_stack/truncate", size, (long long)rounds * (size / 2 + 2), secondsSince(start));
+}
+
+static void benchSortedLinkedList(int size, Random& rng)
+{
+    int* times = new int[size];
+    for (int i = 0; i < size; i++) {
+        times[i] = rng.nextInt(1 << 30);
+    }
+    int rounds = roundsFor(size);
+    // the fill is O(size^2), do not repeat the big ones.
+    if ((long long)rounds * size > 4 * MIN_OPERATIONS / size) {
+        rounds = (int)(4 * MIN_OPERATIONS / size / size);
+        rounds = rounds < 1 ? 1 : rounds;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SortedLinkedList list;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            list.add(Event(times[i], TriageLeave, i, 0));
+        }
+        while (!list.isEmpty()) {
+            checksum += list.removeSmallest().time;
+        }
+    }
+    report("sorted_linked_list/push_pop", size, 2LL * rounds * size, secondsSince(start));
+    delete[] times;
+}
+
+// few distinct times, so most compares go past the time field
+static void benchEventSort(int size, Random& rng)
+{
+    Event* events = new Event[size];
+    EventKey* keys = new EventKey[size];
+    Event* sortedEvents = new Event[size];
+    EventKey* sortedKeys = new EventKey[size];
+    for (int i = 0; i < size; i++) {
+        events[i] = Event(rng.nextInt(64), (EventType)rng.nextInt(8), rng.nextInt(size), rng.nextInt(4) - 1);
+        keys[i] = EventKey(events[i]);
+    }
+    int rounds = (int)(MIN_OPERATIONS / size);
+    rounds = rounds < 1 ? 1 : rounds;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        std::copy(events, events + size, sortedEvents);
+        std::sort(sortedEvents, sortedEvents + size);
+        checksum += sortedEvents[size / 2].patientId;
+    }
+    report("event_sort/event", size, (long long)rounds * size, secondsSince(start));
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        std::copy(keys, keys + size, sortedKeys);
+        std::sort(sortedKeys, sortedKeys + size);
+        checksum += sortedKeys[size / 2].patientId();
+    }
+    report("event_sort/key", size, (long long)rounds * size, secondsSince(start));
+    delete[] events;
+    delete[] keys;
+    delete[] sortedEvents;
+    delete[] sortedKeys;
+}
+
+static const char* engineName(EventSetEngine engine)
+{
+    if (engine == SortedListEngine) {
+        return "sorted_list";
+    }
+    if (engine == CalendarEngine) {
+        return "calendar";
+    }
+    if (engine == RadixEngine) {
+        return "radix";
+    }
+    if (engine == IntrusiveListEngine) {
+        return "intrusive_list";
+    }
+    return "heap";
+}
+
+static void fill(PriorityQueue& queue, int size, Random& rng)
+{
+    for (int i = 0; i < size; i++) {
+        queue.enqueue(Event(increment(rng.next()), TriageLeave, i, 0));
+    }
+}
+
+static void benchHold(EventSetEngine engine, int size, Random& rng)
+{
+    PriorityQueue queue(engine);
+    fill(queue, size, rng);
+    long long operations = holdOperations(engine, size);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        Event e = queue.dequeue();
+        queue.enqueue(Event(e.time + increment(i), e.type, e.patientId, e.resourceId));
+    }
+    report(std::string("priority_queue/hold/") + engineName(engine), size, operations, secondsSince(start));
+    checksum += queue.getFirst().time;
+}
+
+static void benchMarkovHold(EventSetEngine engine, int size, Random& rng)
+{
+    PriorityQueue queue(engine);
+    fill(queue, size, rng);
+    long long operations = holdOperations(engine, size);
+    int now = 0;
+    int nextId = size;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        if (queue.isEmpty() || (rng.next() & 1)) {
+            queue.enqueue(Event(now + increment(i), TriageLeave, nextId, 0));
+            nextId++;
+        }
+        else {
+            now = queue.dequeue().time;
+        }
+    }
+    report(std::string("priority_queue/markov_hold/") + engineName(engine), size, operations, secondsSince(start));
+    checksum += now;
+}
+
+static void benchDES(int numPatients, bool summaryOnly, Random& rng)
+{
+    int* arrivals = new int[numPatients];
+    int* urgencies = new int[numPatients];
+    int now = 0;
+    for (int i = 0; i < numPatients; i++) {
+        now += rng.nextInt(4);
+        arrivals[i] = now;
+        urgencies[i] = rng.nextInt(5);
+    }
+    std::ostream discard(NULL);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    DES sim(4, 8, 5, 3, 20, 40, numPatients, urgencies, arrivals);
+    sim.setOutputStream(discard);
+    sim.setSummaryOnly(summaryOnly);
+    sim.run();
+    double seconds = secondsSince(start);
+    report(summaryOnly ? "des/run_summary" : "des/run", numPatients, sim.getStatistics().eventsProcessed, seconds);
+    delete[] arrivals;
+    delete[] urgencies;
+}
+
+static void benchFork(int numPatients, Random& rng)
+{
+    int* arrivals = new int[numPatients];
+    int* urgencies = new int[numPatients];
+    int now = 0;
+    for (int i = 0; i < numPatients; i++) {
+        now += rng.nextInt(4);
+        arrivals[i] = now;
+        urgencies[i] = rng.nextInt(5);
+    }
+    DES sim(4, 8, 5, 3, 20, 40, numPatients, urgencies, arrivals);
+    sim.setSummaryOnly(true);
+    sim.runUntil(arrivals[numPatients / 2]);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    DES* copy = sim.fork();
+    double seconds = secondsSince(start);
+    report("des/fork", numPatients, numPatients, seconds);
+    checksum += copy->currentTime();
+    delete copy;
+    delete[] arrivals;
+    delete[] urgencies;
+}
+
+static void benchWorkload(int numPatients, unsigned long long seed)
+{
+    static const int CHUNK = 1 << 16;
+    static int arrivals[CHUNK];
+    static int urgencies[CHUNK];
+    double weights[5] = {1, 2, 4, 2, 1};
+    double day[4] = {0.5, 1.0, 2.0, 1.0};
+    WorkloadGenerator generator(seed);
+    generator.setArrivalRate(4.0);
+    generator.setUrgencyWeights(weights, 5);
+    generator.setDailyProfile(1440, day, 4);
+    generator.setBursts(0.001, 50, 30);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int done = 0; done < numPatients; done += CHUNK) {
+        int n = numPatients - done < CHUNK ? numPatients - done : CHUNK;
+        generator.generate(arrivals, urgencies, n);
+        checksum += arrivals[n - 1] + urgencies[n - 1];
+    }
+    report("workload/generate", numPatients, numPatients, secondsSince(start));
+}
+
+int main(int argc, char** argv)
+{
+    int maxSize = 10000000;
+    int maxSorted = 10000;
+    int maxDES = 1000000;
+    unsigned long long seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--max-size") == 0) {
+            maxSize = atoi(argv[i + 1]);
+        }
+        else if (std::strcmp(argv[i], "--max-sorted") == 0) {
+            maxSorted = atoi(argv[i + 1]);
+        }
+        else if (std::strcmp(argv[i], "--max-des") == 0) {
+            maxDES = atoi(argv[i + 1]);
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = strtoull(argv[i + 1], NULL, 10);
+        }
+        else {
+            std::cerr << "unknown option " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    Random rng(seed);
+    drawIncrements(rng);
+    EventSetEngine engines[5] = {HeapEngine, CalendarEngine, RadixEngine, SortedListEngine, IntrusiveListEngine};
+    std::cout << "{\"benchmarks\": [";
+    for (long long size = 10; size <= maxSize; size *= 10) {
+        int n = (int)size;
+        if (selected("linked_list/push_pop")) {
+            benchLinkedList(n);
+        }
+        if (selected("linked_list/move_run")) {
+            benchLinkedListRun(n);
+        }
+        if (selected("fcfs_queue/push_pop")) {
+            benchFCFSQueue(n);
+        }
+        if (selected("intrusive_fcfs_queue/push_pop")) {
+            benchIntrusiveFCFSQueue(n);
+        }
+        if (selected("tiered_fcfs_queue/push_pop")) {
+            benchTieredFCFSQueue(n, rng);
+        }
+        if (selected("monotonic_stack/push_pop")) {
+            benchMonotonicStack(n);
+        }
+        if (selected("monotonic_stack/truncate")) {
+            benchMonotonicTruncate(n);
+        }
+        if (n <= maxSorted && selected("sorted_linked_list/push_pop")) {
+            benchSortedLinkedList(n, rng);
+        }
+        if (selected("event_sort")) {
+            benchEventSort(n, rng);
+        }
+        for (int e = 0; e < 5; e++) {
+            bool sortedList = engines[e] == SortedListEngine || engines[e] == IntrusiveListEngine;
+            if (sortedList && n > maxSorted) {
+                continue;
+            }
+            if (selected(std::string("priority_queue/hold/") + engineName(engines[e]))) {
+                benchHold(engines[e], n, rng);
+            }
+            if (selected(std::string("priority_queue/markov_hold/") + engineName(engines[e]))) {
+                benchMarkovHold(engines[e], n, rng);
+            }
+        }
+        if (n <= maxDES && selected("des/run")) {
+            benchDES(n, false, rng);
+        }
+        if (n <= maxDES && selected("des/run_summary")) {
+            benchDES(n, true, rng);
+        }
+        if (n <= maxDES && selected("des/fork")) {
+            benchFork(n, rng);
+        }
+        if (selected("workload/generate")) {
+            benchWorkload(n, seed);
+        }
+    }
+    std::cout << "\n], \"checksum\": " << checksum << "}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,37 @@
+// Replications per second of one scenario for 1, 2, 4, ... threads.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp replication_bench.cpp -o replication_bench
+// usage: ./replication_bench [replications] [numPatients] [maxThreads]
+#include "ReplicationRunner.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+int main(int argc, char** argv)
+{
+    int replications = (argc > 1) ? atoi(argv[1]) : 64;
+    int numPatients = (argc > 2) ? atoi(argv[2]) : 100000;
+    int maxThreads = (argc > 3) ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    HospitalScenario scenario = {4, 8, 5, 3, 20, 40, numPatients, 2};
+    std::cout << "replications: " << replications << ", patients: " << numPatients << std::endl;
+
+    double single = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ReplicationRunner runner(scenario, replications, 1);
+        runner.setThreads(threads);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        runner.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) {
+            single = seconds;
+        }
+        ReplicationSummary s = runner.summarize();
+        std::cout << threads << " threads: " << seconds << " s, " << replications / seconds << " replications/s"
+                  << " (" << single / seconds << "x), mean finish " << s.meanFinishTime << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Boredom timer workload: one fixed delay timer per patient, most of them
+// cancelled before they fire. Compares the TimingWheel with the indexed
+// EventHeap, then runs DES with the timers on either side.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp timing_wheel_bench.cpp -o timing_wheel_bench
+// usage: ./timing_wheel_bench [numPatients] [seed]
+#include "DES.h"
+#include "EventHeap.h"
+#include "TimingWheel.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// every patient gets a timer at arrival + delay. 9 in 10 are cancelled a
+// little later, the rest fire. Returns a checksum so nothing is optimized out.
+template <typename Timers, typename Schedule, typename Cancel>
+static long long timerWorkload(Timers& timers, Schedule schedule, Cancel cancel,
+                               const int* arrivals, int n, int delay)
+{
+    int* handles = new int[n];
+    long long checksum = 0;
+    int next = 0;
+    for (int i = 0; i < n; i++) {
+        handles[i] = schedule(timers, Event(arrivals[i] + delay, TriageQueueBoringStart, i, -1));
+        // patients that arrived delay / 2 ago leave the queue now.
+        while (next < i && arrivals[next] + delay / 2 <= arrivals[i]) {
+            if (next % 10 != 0) {
+                cancel(timers, handles[next]);
+            }
+            next++;
+        }
+        while (!timers.isEmpty() && timers.getFirst().time <= arrivals[i]) {
+            checksum += timers.removeSmallest().patientId;
+        }
+    }
+    while (!timers.isEmpty()) {
+        checksum += timers.removeSmallest().patientId;
+    }
+    delete[] handles;
+    return checksum;
+}
+
+static int wheelSchedule(TimingWheel& w, const Event& e) { return w.schedule(e); }
+static bool wheelCancel(TimingWheel& w, int h) { return w.cancel(h); }
+static int heapSchedule(EventHeap& h, const Event& e) { return h.addCancellable(e); }
+static bool heapCancel(EventHeap& h, int handle) { return h.cancel(handle); }
+
+int main(int argc, char** argv)
+{
+    int numPatients = (argc > 1) ? atoi(argv[1]) : 10000000;
+    unsigned int seed = (argc > 2) ? (unsigned int)atoi(argv[2]) : 1;
+
+    int* arrivals = new int[numPatients];
+    int* urgencies = new int[numPatients];
+    int now = 0;
+    for (int i = 0; i < numPatients; i++) {
+        seed = seed * 1103515245u + 12345u;
+        now += (int)((seed >> 16) % 4);
+        arrivals[i] = now;
+        urgencies[i] = (int)((seed >> 8) % 5);
+    }
+    std::cout << "patients: " << numPatients << std::endl;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TimingWheel wheel;
+    long long wheelSum = timerWorkload(wheel, wheelSchedule, wheelCancel, arrivals, numPatients, 40);
+    double wheelSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    EventHeap heap;
+    long long heapSum = timerWorkload(heap, heapSchedule, heapCancel, arrivals, numPatients, 40);
+    double heapSeconds = secondsSince(start);
+
+    std::cout << "timers, wheel: " << wheelSeconds << " s" << std::endl;
+    std::cout << "timers, heap: " << heapSeconds << " s (" << heapSeconds / wheelSeconds << "x wheel)" << std::endl;
+    if (wheelSum != heapSum) {
+        std::cout << "checksums differ: " << wheelSum << " " << heapSum << std::endl;
+        return 1;
+    }
+
+    // the trace itself is not what we measure, so switch cout off.
+    double desSeconds[2];
+    std::streambuf* saved = std::cout.rdbuf(NULL);
+    for (int i = 0; i < 2; i++) {
+        start = std::chrono::steady_clock::now();
+        DES sim(4, 8, 5, 3, 20, 40, numPatients, urgencies, arrivals);
+        sim.setTimingWheel(i == 0);
+        sim.setCancelBoredomTimers(true);
+        sim.run();
+        desSeconds[i] = secondsSince(start);
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+    std::cout << "DES, timers on wheel: " << desSeconds[0] << " s" << std::endl;
+    std::cout << "DES, timers in event set: " << desSeconds[1] << " s" << std::endl;
+
+    delete[] arrivals;
+    delete[] urgencies;
+    return 0;
+}
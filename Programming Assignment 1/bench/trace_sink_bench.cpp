@@ -0,0 +1,49 @@
+// Writes the DES trace to a file through each trace sink and reports wall time.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp trace_sink_bench.cpp -o trace_sink_bench
+// usage: ./trace_sink_bench [numPatients] [file]
+#include "BufferedTraceSink.h"
+#include "DES.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    int numPatients = (argc > 1) ? atoi(argv[1]) : 1000000;
+    const char* path = (argc > 2) ? argv[2] : "/dev/null";
+
+    unsigned int seed = 1;
+    int* arrivals = new int[numPatients];
+    int* urgencies = new int[numPatients];
+    int now = 0;
+    for (int i = 0; i < numPatients; i++) {
+        seed = seed * 1103515245u + 12345u;
+        now += (int)((seed >> 16) % 4);
+        arrivals[i] = now;
+        urgencies[i] = (int)((seed >> 8) % 5);
+    }
+
+    std::cout << "patients: " << numPatients << ", trace file: " << path << std::endl;
+    const char* names[2] = {"ostream", "buffered"};
+    for (int i = 0; i < 2; i++) {
+        std::ofstream file(path);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        DES sim(4, 8, 5, 3, 20, 40, numPatients, urgencies, arrivals);
+        if (i == 0) {
+            sim.setOutputStream(file);
+            sim.run();
+        }
+        else {
+            BufferedTraceSink sink(file);
+            sim.setTraceSink(sink);
+            sim.run();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << names[i] << ": " << seconds << " s" << std::endl;
+    }
+
+    delete[] arrivals;
+    delete[] urgencies;
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Compares UnrolledLinkedList<T> with the doubly linked LinkedList<T>
+// (pooled and plain new/delete nodes) for int and Event payloads.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp unrolled_list_bench.cpp -o unrolled_list_bench
+// usage: ./unrolled_list_bench [numElements] [rounds]
+#include "LinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "Event.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int valueOf(int i, int)
+{
+    return i;
+}
+
+static Event valueOf(int i, const Event&)
+{
+    return Event(i, TriageLeave, i, i % 4);
+}
+
+static long checksumOf(int v)
+{
+    return v;
+}
+
+static long checksumOf(const Event& e)
+{
+    return e.time;
+}
+
+// fill, drain as a queue, fill, drain as a stack.
+template <typename List, typename T>
+static double run(int n, int rounds, long& checksum)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    List list;
+    T sample = T();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < n; i++) {
+            list.addBack(valueOf(i, sample));
+        }
+        while (!list.isEmpty()) {
+            checksum += checksumOf(list.removeFront());
+        }
+        for (int i = 0; i < n; i++) {
+            list.addFront(valueOf(i, sample));
+        }
+        while (!list.isEmpty()) {
+            checksum += checksumOf(list.getFront());
+            list.removeFront();
+        }
+    }
+    return secondsSince(start);
+}
+
+template <typename T>
+static void compare(const char* name, int n, int rounds)
+{
+    long checksum = 0;
+    double plain = run<LinkedList<T, HeapNodeAllocator<T> >, T>(n, rounds, checksum);
+    double pooled = run<LinkedList<T>, T>(n, rounds, checksum);
+    double unrolled = run<UnrolledLinkedList<T>, T>(n, rounds, checksum);
+    double ops = 4.0 * n * rounds;
+    std::cout << name << " (" << UnrolledNode<T>::CAPACITY << " per unrolled node)" << std::endl;
+    std::cout << "  LinkedList, new/delete: " << plain / ops * 1e9 << " ns/op" << std::endl;
+    std::cout << "  LinkedList, NodePool:   " << pooled / ops * 1e9 << " ns/op" << std::endl;
+    std::cout << "  UnrolledLinkedList:     " << unrolled / ops * 1e9 << " ns/op" << std::endl;
+    std::cout << "  checksum " << checksum << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 5;
+    compare<int>("int", n, rounds);
+    compare<Event>("Event", n, rounds);
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Runs DES over a grid of hospital configurations against one dataset and
+// prints a CSV row of summary metrics per configuration.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp sweep.cpp -o sweep
+// usage: ./sweep <patients.csv> [--triages a:b[:step]] [--doctors ...] [--tiers ...]
+//                [--triage-duration ...] [--doctor-duration ...] [--boring-duration ...]
+//                [--threads n]
+// patients.csv has one "arrivalTime,urgencyLevel" line per patient.
+#include "ParameterSweep.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// "a", "a:b" or "a:b:step"
+static bool parseRange(const char* text, SweepRange& r)
+{
+    int n = std::sscanf(text, "%d:%d:%d", &r.from, &r.to, &r.step);
+    if (n < 1) {
+        return false;
+    }
+    if (n == 1) {
+        r.to = r.from;
+    }
+    if (n < 3) {
+        r.step = 1;
+    }
+    return true;
+}
+
+static int usage()
+{
+    std::cerr << "usage: sweep <patients.csv> [--triages a:b[:step]] [--doctors ...] [--tiers ...]" << std::endl;
+    std::cerr << "             [--triage-duration ...] [--doctor-duration ...] [--boring-duration ...] [--threads n]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        return usage();
+    }
+    SweepGrid grid = {{2, 2, 1}, {4, 4, 1}, {3, 3, 1}, {3, 3, 1}, {20, 20, 1}, {40, 40, 1}};
+    int threads = 0;
+    for (int i = 2; i < argc; i++) {
+        if (i + 1 == argc) {
+            return usage();
+        }
+        const char* name = argv[i];
+        const char* value = argv[++i];
+        SweepRange* target = NULL;
+        if (std::strcmp(name, "--triages") == 0) {
+            target = &grid.triages;
+        }
+        else if (std::strcmp(name, "--doctors") == 0) {
+            target = &grid.doctors;
+        }
+        else if (std::strcmp(name, "--tiers") == 0) {
+            target = &grid.tiers;
+        }
+        else if (std::strcmp(name, "--triage-duration") == 0) {
+            target = &grid.triageDuration;
+        }
+        else if (std::strcmp(name, "--doctor-duration") == 0) {
+            target = &grid.doctorVisitDuration;
+        }
+        else if (std::strcmp(name, "--boring-duration") == 0) {
+            target = &grid.boringDuration;
+        }
+        else if (std::strcmp(name, "--threads") == 0) {
+            threads = atoi(value);
+            continue;
+        }
+        if (target == NULL || !parseRange(value, *target)) {
+            return usage();
+        }
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    PatientDataset data;
+    int bad = data.loadCsv(file);
+    if (bad != 0) {
+        std::cerr << argv[1] << ":" << bad << ": expected arrivalTime,urgencyLevel" << std::endl;
+        return 1;
+    }
+
+    ParameterSweep sweep(data, grid);
+    sweep.setThreads(threads);
+    sweep.run();
+    sweep.writeCsv(std::cout);
+    return 0;
+}
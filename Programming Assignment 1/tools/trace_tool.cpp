@@ -0,0 +1,58 @@
+// Reads binary DES traces written by BinaryTraceSink.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp trace_tool.cpp -o trace_tool
+// usage: ./trace_tool info <trace>
+//        ./trace_tool text <trace>          the text trace, as DES::run prints it
+//        ./trace_tool query <trace> <fromTime> <toTime> [patientId]
+#include "BinaryTrace.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static int usage()
+{
+    std::cerr << "usage: trace_tool info|text <trace>" << std::endl;
+    std::cerr << "       trace_tool query <trace> <fromTime> <toTime> [patientId]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        return usage();
+    }
+    std::ifstream file(argv[2], std::ios::binary);
+    if (!file) {
+        std::cerr << "cannot open " << argv[2] << std::endl;
+        return 1;
+    }
+    BinaryTraceReader reader(file);
+    if (!reader.isValid()) {
+        std::cerr << argv[2] << " is not a complete binary trace" << std::endl;
+        return 1;
+    }
+
+    OStreamTraceSink out(std::cout);
+    if (std::strcmp(argv[1], "info") == 0) {
+        std::cout << "blocks: " << reader.blockCount() << ", events: " << reader.eventCount() << std::endl;
+        for (int b = 0; b < reader.blockCount(); b++) {
+            const BinaryTraceBlock& info = reader.block(b);
+            std::cout << "block " << b << ": offset " << info.offset << ", events " << info.events
+                      << ", time " << info.minTime << ".." << info.maxTime
+                      << ", patients " << info.minPatient << ".." << info.maxPatient << std::endl;
+        }
+    }
+    else if (std::strcmp(argv[1], "text") == 0) {
+        reader.replay(out);
+    }
+    else if (std::strcmp(argv[1], "query") == 0 && argc >= 5) {
+        int patientId = (argc > 5) ? atoi(argv[5]) : -1;
+        int decoded = reader.query(atoi(argv[3]), atoi(argv[4]), patientId, out);
+        out.flush();
+        std::cerr << "decoded " << decoded << " of " << reader.blockCount() << " blocks" << std::endl;
+    }
+    else {
+        return usage();
+    }
+    return 0;
+}
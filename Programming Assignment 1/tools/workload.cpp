@@ -0,0 +1,148 @@
+// Writes a synthetic patient population for DES, see WorkloadGenerator.
+// build (from this folder): g++ -O2 -pthread -I.. ../*.cpp workload.cpp -o workload
+// usage: ./workload <out> [--patients n] [--rate r] [--seed s] [--urgency w0,w1,...]
+//                   [--profile period:m0,m1,...] [--bursts rate:size:spread]
+//                   [--burst-urgency w0,w1,...] [--end time] [--binary]
+// <out> is "-" for stdout. The output is CSV unless --binary is given; both
+// can be read back by MappedArrivalFile and the CSV one by sweep.
+#include "WorkloadGenerator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const int MAX_WEIGHTS = 256;
+
+// "w0,w1,..." into weights, returns how many, 0 if malformed
+static int parseWeights(const char* text, double* weights)
+{
+    int n = 0;
+    while (n < MAX_WEIGHTS) {
+        char* end;
+        weights[n] = std::strtod(text, &end);
+        if (end == text) {
+            return 0;
+        }
+        n++;
+        if (*end == '\0') {
+            return n;
+        }
+        if (*end != ',') {
+            return 0;
+        }
+        text = end + 1;
+    }
+    return 0;
+}
+
+static int usage()
+{
+    std::cerr << "usage: workload <out> [--patients n] [--rate r] [--seed s] [--urgency w0,w1,...]" << std::endl;
+    std::cerr << "                [--profile period:m0,m1,...] [--bursts rate:size:spread]" << std::endl;
+    std::cerr << "                [--burst-urgency w0,w1,...] [--end time] [--binary]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        return usage();
+    }
+    long long patients = 1000000;
+    unsigned long long seed = 1;
+    bool binary = false;
+    double rate = 1.0;
+    double weights[MAX_WEIGHTS];
+    int numWeights = 0;
+    double burstWeights[MAX_WEIGHTS];
+    int numBurstWeights = 0;
+    double profile[MAX_WEIGHTS];
+    int profileSlots = 0;
+    int period = 0;
+    double burstRate = 0.0;
+    int burstSize = 0;
+    int burstSpread = 0;
+    int endTime = -1;
+    for (int i = 2; i < argc; i++) {
+        const char* name = argv[i];
+        if (std::strcmp(name, "--binary") == 0) {
+            binary = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return usage();
+        }
+        const char* value = argv[++i];
+        bool ok = true;
+        if (std::strcmp(name, "--patients") == 0) {
+            patients = atoll(value);
+        }
+        else if (std::strcmp(name, "--rate") == 0) {
+            rate = atof(value);
+        }
+        else if (std::strcmp(name, "--seed") == 0) {
+            seed = strtoull(value, NULL, 10);
+        }
+        else if (std::strcmp(name, "--urgency") == 0) {
+            numWeights = parseWeights(value, weights);
+            ok = numWeights > 0;
+        }
+        else if (std::strcmp(name, "--burst-urgency") == 0) {
+            numBurstWeights = parseWeights(value, burstWeights);
+            ok = numBurstWeights > 0;
+        }
+        else if (std::strcmp(name, "--profile") == 0) {
+            const char* colon = std::strchr(value, ':');
+            period = atoi(value);
+            profileSlots = colon == NULL ? 0 : parseWeights(colon + 1, profile);
+            ok = profileSlots > 0;
+        }
+        else if (std::strcmp(name, "--bursts") == 0) {
+            ok = std::sscanf(value, "%lf:%d:%d", &burstRate, &burstSize, &burstSpread) == 3;
+        }
+        else if (std::strcmp(name, "--end") == 0) {
+            endTime = atoi(value);
+        }
+        else {
+            ok = false;
+        }
+        if (!ok) {
+            return usage();
+        }
+    }
+
+    WorkloadGenerator generator(seed);
+    generator.setArrivalRate(rate);
+    if (numWeights > 0 && !generator.setUrgencyWeights(weights, numWeights)) {
+        std::cerr << "--urgency needs a positive weight" << std::endl;
+        return 1;
+    }
+    if (numBurstWeights > 0 && !generator.setBurstUrgencyWeights(burstWeights, numBurstWeights)) {
+        std::cerr << "--burst-urgency needs a positive weight" << std::endl;
+        return 1;
+    }
+    if (profileSlots > 0 && !generator.setDailyProfile(period, profile, profileSlots)) {
+        std::cerr << "--profile needs a positive period and a positive multiplier" << std::endl;
+        return 1;
+    }
+    generator.setBursts(burstRate, burstSize, burstSpread);
+    if (endTime >= 0) {
+        generator.setEndTime(endTime);
+    }
+
+    std::ofstream file;
+    bool toStdout = std::strcmp(argv[1], "-") == 0;
+    if (!toStdout) {
+        file.open(argv[1], binary ? std::ios::binary : std::ios::out);
+        if (!file) {
+            std::cerr << "cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = toStdout ? std::cout : file;
+    long long written = binary ? generator.writeBinary(out, patients) : generator.writeCsv(out, patients);
+    out.flush();
+    std::cerr << written << " patients" << std::endl;
+    return out ? 0 : 1;
+}